@@ -0,0 +1,4 @@
+CONFIG += qskexample
+
+SOURCES += \
+    main.cpp
@@ -0,0 +1,203 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+/*
+    Benchmark for arcs, that are animated: a grid of rings, where
+    the span angles are changing with each frame. The time being spent
+    in synchronizing the scene graph is reported once per second.
+
+    arcs [count]
+ */
+
+#include <QskAnimator.h>
+#include <QskArcMetrics.h>
+#include <QskControl.h>
+#include <QskGradient.h>
+#include <QskGradientDirection.h>
+#include <QskGridBox.h>
+#include <QskObjectCounter.h>
+#include <QskSkinlet.h>
+#include <QskWindow.h>
+
+#include <SkinnyShortcut.h>
+
+#include <QElapsedTimer>
+#include <QGuiApplication>
+#include <QtMath>
+#include <QDebug>
+
+#include <atomic>
+
+class Ring : public QskControl
+{
+  public:
+    QSK_SUBCONTROLS( Groove, Bar )
+
+    Ring( int index, QQuickItem* parent = nullptr )
+        : QskControl( parent )
+        , m_index( index )
+    {
+        static Skinlet skinlet;
+        setSkinlet( &skinlet );
+
+        setArcMetricsHint( Groove, { 4, 90, -360 } );
+        setArcMetricsHint( Bar, { 4, 90, -270 } );
+
+        setGradientHint( Groove, QColor( 220, 220, 220 ) );
+
+        QskGradient gradient( Qt::darkCyan, Qt::magenta );
+        gradient.setLinearDirection( Qt::Horizontal );
+
+        setGradientHint( Bar, gradient );
+
+        setPreferredSize( 40, 40 );
+    }
+
+    void setProgress( qreal progress )
+    {
+        const qreal value = 0.5 + 0.5 * qSin( 2 * M_PI * progress + 0.1 * m_index );
+
+        auto metrics = arcMetricsHint( Bar );
+        metrics.setSpanAngle( -360 * value );
+
+        setArcMetricsHint( Bar, metrics );
+    }
+
+  private:
+    class Skinlet : public QskSkinlet
+    {
+      public:
+        enum NodeRole { GrooveRole, BarRole };
+
+        Skinlet()
+        {
+            setNodeRoles( { GrooveRole, BarRole } );
+        }
+
+      protected:
+        QSGNode* updateSubNode( const QskSkinnable* skinnable,
+            quint8 nodeRole, QSGNode* node ) const override
+        {
+            switch( nodeRole )
+            {
+                case GrooveRole:
+                    return updateArcNode( skinnable, node, Ring::Groove );
+
+                case BarRole:
+                    return updateArcNode( skinnable, node, Ring::Bar );
+            }
+
+            return Inherited::updateSubNode( skinnable, nodeRole, node );
+        }
+
+      private:
+        using Inherited = QskSkinlet;
+    };
+
+    const int m_index;
+};
+
+QSK_SUBCONTROL( Ring, Groove )
+QSK_SUBCONTROL( Ring, Bar )
+
+class Animator : public QskAnimator
+{
+  public:
+    Animator( const QVector< Ring* >& rings )
+        : m_rings( rings )
+    {
+        setDuration( 4000 );
+        setAutoRepeat( true );
+    }
+
+  protected:
+    void advance( qreal progress ) override
+    {
+        for ( auto ring : qAsConst( m_rings ) )
+            ring->setProgress( progress );
+    }
+
+  private:
+    const QVector< Ring* > m_rings;
+};
+
+class Statistics : public QObject
+{
+  public:
+    Statistics( QQuickWindow* window )
+    {
+        // the scene graph thread
+
+        connect( window, &QQuickWindow::beforeSynchronizing,
+            this, [this]() { m_timer.start(); }, Qt::DirectConnection );
+
+        connect( window, &QQuickWindow::afterSynchronizing,
+            this, [this]() { m_elapsed += m_timer.nsecsElapsed(); m_frames++; },
+            Qt::DirectConnection );
+
+        startTimer( 1000 );
+    }
+
+  protected:
+    void timerEvent( QTimerEvent* ) override
+    {
+        const int frames = m_frames.exchange( 0 );
+        const qint64 elapsed = m_elapsed.exchange( 0 );
+
+        if ( frames > 0 )
+        {
+            qDebug() << "Frames:" << frames
+                << "Sync/frame (ms):" << 1e-6 * elapsed / frames;
+        }
+    }
+
+  private:
+    QElapsedTimer m_timer;
+
+    std::atomic< int > m_frames { 0 };
+    std::atomic< qint64 > m_elapsed { 0 };
+};
+
+int main( int argc, char* argv[] )
+{
+#ifdef ITEM_STATISTICS
+    QskObjectCounter counter( true );
+#endif
+
+    QGuiApplication app( argc, argv );
+
+    SkinnyShortcut::enable( SkinnyShortcut::AllShortcuts );
+
+    const int count = ( argc > 1 ) ? qMax( 1, atoi( argv[1] ) ) : 400;
+    const int columns = qCeil( qSqrt( count ) );
+
+    auto box = new QskGridBox();
+    box->setMargins( 10 );
+    box->setSpacing( 5 );
+
+    QVector< Ring* > rings;
+    rings.reserve( count );
+
+    for ( int i = 0; i < count; i++ )
+    {
+        auto ring = new Ring( i );
+        box->addItem( ring, i / columns, i % columns );
+
+        rings += ring;
+    }
+
+    QskWindow window;
+    window.addItem( box );
+    window.resize( 900, 900 );
+    window.show();
+
+    Statistics statistics( &window );
+
+    Animator animator( rings );
+    animator.setWindow( &window );
+    animator.start();
+
+    return app.exec();
+}
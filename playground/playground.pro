@@ -2,6 +2,7 @@ TEMPLATE = subdirs
 
 SUBDIRS += \
     anchors \
+    arcs \
     dials \
     dialogbuttons \
     gradients \
@@ -9,7 +10,8 @@ SUBDIRS += \
     inputpanel \
     images \
     shadows \
-    shapes
+    shapes \
+    transitions
 
 qtHaveModule(webengine) {
 
@@ -0,0 +1,199 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+/*
+    Benchmark for skin transitions with several windows: each window
+    shows a grid of controls and the skin is changed periodically.
+    The time being spent in advancing the animators is reported
+    once per second.
+
+    transitions [windows] [controls]
+ */
+
+#include <QskAnimator.h>
+#include <QskCheckBox.h>
+#include <QskGridBox.h>
+#include <QskObjectCounter.h>
+#include <QskProgressBar.h>
+#include <QskPushButton.h>
+#include <QskSkinTransition.h>
+#include <QskSlider.h>
+#include <QskSwitchButton.h>
+#include <QskTextLabel.h>
+#include <QskWindow.h>
+
+#include <SkinnyNamespace.h>
+#include <SkinnyShortcut.h>
+
+#include <QElapsedTimer>
+#include <QGuiApplication>
+#include <QHash>
+#include <QTimer>
+#include <QtMath>
+#include <QDebug>
+
+namespace
+{
+    class Window : public QskWindow
+    {
+      public:
+        Window( int index, int count )
+        {
+            const int columns = qCeil( qSqrt( count ) );
+
+            auto box = new QskGridBox();
+            box->setMargins( 10 );
+            box->setSpacing( 5 );
+
+            for ( int i = 0; i < count; i++ )
+                box->addItem( createControl( i ), i / columns, i % columns );
+
+            addItem( box );
+
+            setTitle( QStringLiteral( "Window %1" ).arg( index + 1 ) );
+            resize( 600, 600 );
+        }
+
+      private:
+        QskControl* createControl( int i ) const
+        {
+            switch( i % 6 )
+            {
+                case 0:
+                    return new QskPushButton( QString::number( i ) );
+
+                case 1:
+                {
+                    auto slider = new QskSlider();
+                    slider->setValueAsRatio( ( i % 10 ) / 10.0 );
+
+                    return slider;
+                }
+
+                case 2:
+                {
+                    auto progressBar = new QskProgressBar();
+                    progressBar->setValueAsRatio( ( i % 10 ) / 10.0 );
+
+                    return progressBar;
+                }
+
+                case 3:
+                {
+                    auto checkBox = new QskCheckBox();
+                    checkBox->setChecked( i % 2 );
+
+                    return checkBox;
+                }
+
+                case 4:
+                {
+                    auto switchButton = new QskSwitchButton();
+                    switchButton->setChecked( i % 2 );
+
+                    return switchButton;
+                }
+
+                default:
+                    return new QskTextLabel( QString::number( i ) );
+            }
+        }
+    };
+
+    class Statistics : public QObject
+    {
+        Q_OBJECT
+
+      public:
+        Statistics()
+        {
+            QskAnimator::addAdvanceHandler( this, SLOT(advanced(QQuickWindow*)) );
+            startTimer( 1000 );
+        }
+
+        void addWindow( QQuickWindow* window )
+        {
+            connect( window, &QQuickWindow::afterAnimating,
+                this, [this, window]() { m_timers[ window ].start(); },
+                Qt::DirectConnection );
+        }
+
+      protected:
+        void timerEvent( QTimerEvent* ) override
+        {
+            if ( m_ticks > 0 )
+            {
+                qDebug() << "Ticks:" << m_ticks
+                    << "Animating/tick (ms):" << 1e-6 * m_elapsed / m_ticks;
+            }
+
+            m_ticks = 0;
+            m_elapsed = 0;
+        }
+
+      private Q_SLOTS:
+        void advanced( QQuickWindow* window )
+        {
+            auto& timer = m_timers[ window ];
+            if ( timer.isValid() && QskSkinTransition::isRunning() )
+            {
+                m_elapsed += timer.nsecsElapsed();
+                m_ticks++;
+            }
+
+            timer.invalidate();
+        }
+
+      private:
+        QHash< const QQuickWindow*, QElapsedTimer > m_timers;
+
+        int m_ticks = 0;
+        qint64 m_elapsed = 0;
+    };
+}
+
+int main( int argc, char* argv[] )
+{
+#ifdef ITEM_STATISTICS
+    QskObjectCounter counter( true );
+#endif
+
+    QGuiApplication app( argc, argv );
+
+    SkinnyShortcut::enable( SkinnyShortcut::AllShortcuts );
+
+    const int windowCount = ( argc > 1 ) ? qMax( 1, atoi( argv[1] ) ) : 4;
+    const int controlCount = ( argc > 2 ) ? qMax( 1, atoi( argv[2] ) ) : 200;
+
+    Statistics statistics;
+
+    QVector< Window* > windows;
+
+    for ( int i = 0; i < windowCount; i++ )
+    {
+        auto window = new Window( i, controlCount );
+        window->setPosition( 50 + 30 * i, 50 + 30 * i );
+        window->show();
+
+        statistics.addWindow( window );
+        windows += window;
+    }
+
+    QTimer timer;
+    timer.setInterval( 2000 );
+
+    QObject::connect( &timer, &QTimer::timeout,
+        []() { Skinny::changeSkin( 1000 ); } );
+
+    timer.start();
+
+    const int ret = app.exec();
+
+    qDeleteAll( windows );
+
+    return ret;
+}
+
+#include "main.moc"
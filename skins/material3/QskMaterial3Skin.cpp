@@ -45,10 +45,12 @@
 #include <QskBoxShapeMetrics.h>
 #include <QskMargins.h>
 #include <QskRgbValue.h>
+#include <QskSkinSnapshot.h>
 
 #include <QskNamespace.h>
 #include <QskPlatform.h>
 
+#include <QFile>
 #include <QGuiApplication>
 #include <QScreen>
 
@@ -1059,11 +1061,15 @@ const QskGraphic* QskMaterial3GraphicProvder::loadGraphic( const QString& id ) c
     return graphic.isNull() ? nullptr : new QskGraphic( graphic );
 }
 
-QskMaterial3Skin::QskMaterial3Skin( const QskMaterial3Theme& palette, QObject* parent )
+QskMaterial3Skin::QskMaterial3Skin( QObject* parent )
     : Inherited( parent )
 {
     addGraphicProvider( {}, new QskMaterial3GraphicProvder() );
+}
 
+QskMaterial3Skin::QskMaterial3Skin( const QskMaterial3Theme& palette, QObject* parent )
+    : QskMaterial3Skin( parent )
+{
     setupFonts();
     setupGraphicFilters( palette );
 
@@ -1075,6 +1081,26 @@ QskMaterial3Skin::~QskMaterial3Skin()
 {
 }
 
+QskMaterial3Skin* QskMaterial3Skin::fromSnapshot(
+    const QString& fileName, QObject* parent )
+{
+    if ( fileName.isEmpty() || !QFile::exists( fileName ) )
+        return nullptr;
+
+    auto skin = new QskMaterial3Skin( parent );
+    if ( QskSkinSnapshot::read( skin, fileName ) )
+        return skin;
+
+    delete skin;
+    return nullptr;
+}
+
+QByteArray QskMaterial3Skin::snapshotKey() const
+{
+    // to be increased, whenever the hints set up by the Editor change
+    return QByteArrayLiteral( "QskMaterial3Skin/1" );
+}
+
 QskGraphic QskMaterial3Skin::symbol( int symbolType ) const
 {
     switch ( symbolType )
@@ -1082,7 +1108,7 @@ QskGraphic QskMaterial3Skin::symbol( int symbolType ) const
     case QskStandardSymbol::CheckMark:
     {
         const auto* provider = graphicProvider( {} );
-        return *( provider->requestGraphic( "check_small" ) );
+        return provider->requestGraphic( "check_small" );
     }
     case QskStandardSymbol::CrossMark:
     {
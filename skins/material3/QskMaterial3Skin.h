@@ -120,6 +120,11 @@ class QSK_MATERIAL3_EXPORT QskMaterial3Skin : public QskSkin
     QskMaterial3Skin( const QskMaterial3Theme&, QObject* parent = nullptr );
     ~QskMaterial3Skin() override;
 
+    // restored from a snapshot ( see QskSkinSnapshot ), nullptr on failure
+    static QskMaterial3Skin* fromSnapshot(
+        const QString& fileName, QObject* parent = nullptr );
+
+    virtual QByteArray snapshotKey() const override;
     virtual QskGraphic symbol( int symbolType ) const override;
 
     enum GraphicRole
@@ -138,6 +143,8 @@ class QSK_MATERIAL3_EXPORT QskMaterial3Skin : public QskSkin
     };
 
   private:
+    QskMaterial3Skin( QObject* parent );
+
     void setupFonts();
     void setupGraphicFilters( const QskMaterial3Theme& palette );
 };
@@ -6,9 +6,28 @@
 #include "QskMaterial3SkinFactory.h"
 #include "QskMaterial3Skin.h"
 
+#include <QskSkinSnapshot.h>
+
 static const QString materialLightSkinName = QStringLiteral( "Material3 Light" );
 static const QString materialDarkSkinName = QStringLiteral( "Material3 Dark" );
 
+static QskSkin* qskCreateSkin(
+    const QString& skinName, QskMaterial3Theme::Lightness lightness )
+{
+    /*
+        Calculating the palette and setting up the hint table is expensive.
+        When snapshots are enabled we try to restore the skin from a
+        snapshot, that has been written in advance.
+     */
+    const auto snapshot = QskSkinSnapshot::fileName( skinName );
+
+    if ( auto skin = QskMaterial3Skin::fromSnapshot( snapshot ) )
+        return skin;
+
+    QskMaterial3Theme theme( lightness );
+    return new QskMaterial3Skin( theme );
+}
+
 QskMaterial3SkinFactory::QskMaterial3SkinFactory( QObject* parent )
     : QskSkinFactory( parent )
 {
@@ -26,15 +45,10 @@ QStringList QskMaterial3SkinFactory::skinNames() const
 QskSkin* QskMaterial3SkinFactory::createSkin( const QString& skinName )
 {
     if ( QString::compare( skinName, materialLightSkinName, Qt::CaseInsensitive ) == 0 )
-    {
-        QskMaterial3Theme theme( QskMaterial3Theme::Light );
-        return new QskMaterial3Skin( theme );
-    }
-    else if ( QString::compare( skinName, materialDarkSkinName, Qt::CaseInsensitive ) == 0 )
-    {
-        QskMaterial3Theme theme( QskMaterial3Theme::Dark );
-        return new QskMaterial3Skin( theme );
-    }
+        return qskCreateSkin( materialLightSkinName, QskMaterial3Theme::Light );
+
+    if ( QString::compare( skinName, materialDarkSkinName, Qt::CaseInsensitive ) == 0 )
+        return qskCreateSkin( materialDarkSkinName, QskMaterial3Theme::Dark );
 
     return nullptr;
 }
@@ -42,6 +42,9 @@
 #include <QskMargins.h>
 #include <QskNamespace.h>
 #include <QskRgbValue.h>
+#include <QskSkinSnapshot.h>
+
+#include <QFile>
 
 static const int qskDuration = 200;
 
@@ -1027,19 +1030,47 @@ class QskSquiekSkin::PrivateData
 };
 
 QskSquiekSkin::QskSquiekSkin( QObject* parent )
+    : QskSquiekSkin( parent, true )
+{
+}
+
+QskSquiekSkin::QskSquiekSkin( QObject* parent, bool doSetup )
     : Inherited( parent )
     , m_data( new PrivateData() )
 {
-    setupFonts( QStringLiteral( "DejaVuSans" ) );
+    if ( doSetup )
+    {
+        setupFonts( QStringLiteral( "DejaVuSans" ) );
 
-    Editor editor( &hintTable(), m_data->palette );
-    editor.setup();
+        Editor editor( &hintTable(), m_data->palette );
+        editor.setup();
+    }
 }
 
 QskSquiekSkin::~QskSquiekSkin()
 {
 }
 
+QskSquiekSkin* QskSquiekSkin::fromSnapshot(
+    const QString& fileName, QObject* parent )
+{
+    if ( fileName.isEmpty() || !QFile::exists( fileName ) )
+        return nullptr;
+
+    auto skin = new QskSquiekSkin( parent, false );
+    if ( QskSkinSnapshot::read( skin, fileName ) )
+        return skin;
+
+    delete skin;
+    return nullptr;
+}
+
+QByteArray QskSquiekSkin::snapshotKey() const
+{
+    // to be increased, whenever the hints set up by the Editor change
+    return QByteArrayLiteral( "QskSquiekSkin/1" );
+}
+
 void QskSquiekSkin::resetColors( const QColor& accent )
 {
     m_data->palette = ColorPalette( accent );
@@ -20,7 +20,15 @@ class QSK_SQUIEK_EXPORT QskSquiekSkin : public QskSkin
     QskSquiekSkin( QObject* parent = nullptr );
     ~QskSquiekSkin() override;
 
+    // restored from a snapshot ( see QskSkinSnapshot ), nullptr on failure
+    static QskSquiekSkin* fromSnapshot(
+        const QString& fileName, QObject* parent = nullptr );
+
+    QByteArray snapshotKey() const override;
+
   private:
+    QskSquiekSkin( QObject* parent, bool doSetup );
+
     void resetColors( const QColor& accent ) override;
 
     class PrivateData;
@@ -6,6 +6,8 @@
 #include "QskSquiekSkinFactory.h"
 #include "QskSquiekSkin.h"
 
+#include <QskSkinSnapshot.h>
+
 static const QString squiekSkinName = QStringLiteral( "Squiek" );
 
 QskSquiekSkinFactory::QskSquiekSkinFactory( QObject* parent )
@@ -25,7 +27,14 @@ QStringList QskSquiekSkinFactory::skinNames() const
 QskSkin* QskSquiekSkinFactory::createSkin( const QString& skinName )
 {
     if ( QString::compare( skinName, squiekSkinName, Qt::CaseInsensitive ) == 0 )
+    {
+        const auto snapshot = QskSkinSnapshot::fileName( squiekSkinName );
+
+        if ( auto skin = QskSquiekSkin::fromSnapshot( snapshot ) )
+            return skin;
+
         return new QskSquiekSkin();
+    }
 
     return nullptr;
 }
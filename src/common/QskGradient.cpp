@@ -557,6 +557,52 @@ QskGradient QskGradient::interpolated( const QskGradient& to, qreal ratio ) cons
     return gradient;
 }
 
+void QskGradient::setInterpolated( const QskGradient& from,
+    const QskGradient& to, qreal ratio )
+{
+    const auto& stops1 = from.m_stops;
+    const auto& stops2 = to.m_stops;
+
+    bool samePositions = !stops1.isEmpty() && ( stops1.count() == stops2.count() )
+        && qskCanBeInterpolated( from, to );
+
+    for ( int i = 0; samePositions && i < stops1.count(); i++ )
+    {
+        samePositions = qFuzzyCompare(
+            stops1[i].position(), stops2[i].position() );
+    }
+
+    if ( !samePositions )
+    {
+        *this = from.interpolated( to, ratio );
+        return;
+    }
+
+    /*
+        For stops at the same positions qskInterpolatedGradientStops
+        interpolates the colors pairwise. We can do the same in place,
+        so that animations don't need to allocate memory for each step.
+     */
+
+    if ( m_stops.count() != stops1.count() )
+        m_stops = stops1;
+
+    for ( int i = 0; i < stops1.count(); i++ )
+    {
+        m_stops[i].setStop( stops1[i].position(), QskRgb::interpolated(
+            stops1[i].color(), stops2[i].color(), ratio ) );
+    }
+
+    for ( uint i = 0; i < sizeof( m_values ) / sizeof( m_values[0] ); i++ )
+        m_values[i] = from.m_values[i] + ratio * ( to.m_values[i] - from.m_values[i] );
+
+    m_type = to.m_type;
+    m_spreadMode = to.m_spreadMode;
+    m_stretchMode = to.m_stretchMode;
+
+    m_isDirty = true;
+}
+
 QVariant QskGradient::interpolate(
     const QskGradient& from, const QskGradient& to, qreal progress )
 {
@@ -142,6 +142,13 @@ class QSK_EXPORT QskGradient
 
     QskGradient interpolated( const QskGradient&, qreal value ) const;
 
+    /*
+        Same as *this = from.interpolated( to, value ), but reusing the memory
+        of the stops, when both gradients have stops at the same positions.
+     */
+    void setInterpolated( const QskGradient& from,
+        const QskGradient& to, qreal value );
+
     void stretchTo( const QRectF& );
     QskGradient stretchedTo( const QSizeF& ) const;
     QskGradient stretchedTo( const QRectF& ) const;
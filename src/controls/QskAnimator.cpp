@@ -7,6 +7,7 @@
 
 #include <qelapsedtimer.h>
 #include <qglobalstatic.h>
+#include <qhash.h>
 #include <qobject.h>
 #include <qquickwindow.h>
 #include <qvector.h>
@@ -74,6 +75,10 @@ namespace
         We need to have at least one QObject to connect to QQuickWindow
         updates - but then we can advance the animators manually without
         making them heavy QObjects too.
+
+        The animators are bucketed per window, so that each frame
+        iterates over the animators of its window only - in one pass,
+        using the same reference time for all of them.
      */
     class AnimatorDriver final : public QObject
     {
@@ -81,33 +86,64 @@ namespace
 
       public:
         AnimatorDriver();
+        ~AnimatorDriver() override;
 
         void registerAnimator( QskAnimator* );
         void unregisterAnimator( QskAnimator* );
 
         qint64 referenceTime() const;
 
+        QskAnimator::FrameStatistics frameStatistics( const QQuickWindow* ) const;
+
       Q_SIGNALS:
         void advanced( QQuickWindow* );
         void terminated( QQuickWindow* );
 
       private:
+        class Bucket
+        {
+          public:
+            QQuickWindow* window = nullptr;
+
+            /*
+                The animators of the window in a contiguous array.
+                Animators being removed while advancing are replaced
+                by nullptr and the array is compacted afterwards.
+             */
+            QVector< QskAnimator* > animators;
+
+            QskAnimator::FrameStatistics statistics;
+
+            QMetaObject::Connection connections[2];
+
+            bool isAdvancing = false;
+            bool hasGaps = false;
+        };
+
+        Bucket* bucket( const QQuickWindow* ) const;
+        Bucket* insertBucket( QQuickWindow* );
+
+        void connectFrames( Bucket* );
+        void disconnectFrames( Bucket* );
+
+        void compact( Bucket* );
+
         void advanceAnimators( QQuickWindow* );
         void removeWindow( QQuickWindow* );
         void scheduleUpdate( QQuickWindow* );
 
         QElapsedTimer m_referenceTime;
-
-        // a sorted vector, good for iterating and good enough for look ups
-        QVector< QskAnimator* > m_animators;
+        qint64 m_frameTime = -1; // while advancing
 
         /*
            Having a more than a very few windows with running animators is
            very unlikely and using a hash table instead of a vector probably
            creates more overhead than being good for something.
          */
-        QVector< QQuickWindow* > m_windows;
-        mutable int m_index = -1; // current value, when iterating
+        QVector< Bucket* > m_buckets;
+
+        // the position of an animator inside the array of its bucket
+        QHash< const QskAnimator*, int > m_positions;
     };
 }
 
@@ -116,9 +152,75 @@ AnimatorDriver::AnimatorDriver()
     m_referenceTime.start();
 }
 
+AnimatorDriver::~AnimatorDriver()
+{
+    qDeleteAll( m_buckets );
+}
+
 inline qint64 AnimatorDriver::referenceTime() const
 {
-    return m_referenceTime.elapsed();
+    return ( m_frameTime >= 0 ) ? m_frameTime : m_referenceTime.elapsed();
+}
+
+QskAnimator::FrameStatistics AnimatorDriver::frameStatistics(
+    const QQuickWindow* window ) const
+{
+    if ( const auto b = bucket( window ) )
+        return b->statistics;
+
+    return QskAnimator::FrameStatistics();
+}
+
+AnimatorDriver::Bucket* AnimatorDriver::bucket( const QQuickWindow* window ) const
+{
+    for ( auto b : m_buckets )
+    {
+        if ( b->window == window )
+            return b;
+    }
+
+    return nullptr;
+}
+
+AnimatorDriver::Bucket* AnimatorDriver::insertBucket( QQuickWindow* window )
+{
+    auto b = new Bucket();
+    b->window = window;
+
+    m_buckets += b;
+
+    connect( window, &QWindow::visibleChanged,
+        this, [ this, window ]( bool on ) { if ( !on ) removeWindow( window ); } );
+
+    connect( window, &QObject::destroyed,
+        this, [ this, window ]( QObject* ) { removeWindow( window ); } );
+
+    return b;
+}
+
+void AnimatorDriver::connectFrames( Bucket* b )
+{
+    if ( b->connections[0] )
+        return;
+
+    const auto window = b->window;
+
+    b->connections[0] = connect( window, &QQuickWindow::afterAnimating,
+        this, [ this, window ]() { advanceAnimators( window ); } );
+
+    b->connections[1] = connect( window, &QQuickWindow::frameSwapped,
+        this, [ this, window ]() { scheduleUpdate( window ); } );
+
+    window->update();
+}
+
+void AnimatorDriver::disconnectFrames( Bucket* b )
+{
+    for ( auto& connection : b->connections )
+    {
+        disconnect( connection );
+        connection = QMetaObject::Connection();
+    }
 }
 
 void AnimatorDriver::registerAnimator( QskAnimator* animator )
@@ -127,104 +229,177 @@ void AnimatorDriver::registerAnimator( QskAnimator* animator )
 
     // do we want to be thread safe ???
 
-    auto it = std::lower_bound( m_animators.begin(), m_animators.end(), animator );
-    if ( it != m_animators.end() && *it == animator )
+    if ( m_positions.contains( animator ) )
         return;
 
-    if ( m_index > 0 )
-    {
-        if ( it - m_animators.begin() < m_index )
-            m_index++;
-    }
+    auto window = animator->window();
+    if ( window == nullptr )
+        return;
 
-    m_animators.insert( it, animator );
+    auto b = bucket( window );
+    if ( b == nullptr )
+        b = insertBucket( window );
 
-    if ( auto window = animator->window() )
+    /*
+        When being added while advancing the animator will
+        be advanced with the next frame.
+     */
+    m_positions.insert( animator, b->animators.size() );
+    b->animators += animator;
+
+    connectFrames( b );
+}
+
+void AnimatorDriver::unregisterAnimator( QskAnimator* animator )
+{
+    const auto it = m_positions.constFind( animator );
+    if ( it == m_positions.constEnd() )
+        return;
+
+    const int pos = it.value();
+    m_positions.erase( it );
+
+    auto b = bucket( animator->window() );
+
+    Q_ASSERT( b && b->animators.value( pos ) == animator );
+    if ( b == nullptr || b->animators.value( pos ) != animator )
+        return;
+
+    if ( b->isAdvancing )
     {
-        if ( !m_windows.contains( window ) )
-        {
-            m_windows += window;
+        b->animators[pos] = nullptr;
+        b->hasGaps = true;
+    }
+    else
+    {
+        // moving the last one into the gap
 
-            connect( window, &QQuickWindow::afterAnimating,
-                this, [ this, window ]() { advanceAnimators( window ); } );
+        const auto last = b->animators.takeLast();
+        if ( last != animator )
+        {
+            b->animators[pos] = last;
+            m_positions[ last ] = pos;
+        }
+    }
+}
 
-            connect( window, &QQuickWindow::frameSwapped,
-                this, [ this, window ]() { scheduleUpdate( window ); } );
+void AnimatorDriver::compact( Bucket* b )
+{
+    if ( !b->hasGaps )
+        return;
 
-            connect( window, &QWindow::visibleChanged,
-                this, [ this, window ]( bool on ) { if ( !on ) removeWindow( window ); } );
+    auto& animators = b->animators;
 
-            connect( window, &QObject::destroyed,
-                this, [ this, window ]( QObject* ) { removeWindow( window ); } );
+    int pos = 0;
+    for ( int i = 0; i < animators.size(); i++ )
+    {
+        if ( const auto animator = animators[i] )
+        {
+            if ( i != pos )
+            {
+                animators[pos] = animator;
+                m_positions[ animator ] = pos;
+            }
 
-            window->update();
+            pos++;
         }
     }
+
+    animators.resize( pos );
+    b->hasGaps = false;
 }
 
 void AnimatorDriver::scheduleUpdate( QQuickWindow* window )
 {
-    if ( m_windows.contains( window ) )
+    if ( bucket( window ) )
         window->update();
 }
 
 void AnimatorDriver::removeWindow( QQuickWindow* window )
 {
     window->disconnect( this );
-    m_windows.removeOne( window );
 
-    for ( auto it = m_animators.begin(); it != m_animators.end(); )
+    for ( int i = 0; i < m_buckets.size(); i++ )
     {
-        if ( ( *it )->window() == window )
-            it = m_animators.erase( it );
-        else
-            ++it;
-    }
-}
+        auto b = m_buckets[i];
+        if ( b->window == window )
+        {
+            for ( const auto animator : qAsConst( b->animators ) )
+            {
+                if ( animator )
+                    m_positions.remove( animator );
+            }
 
-void AnimatorDriver::unregisterAnimator( QskAnimator* animator )
-{
-    auto it = std::find( m_animators.begin(), m_animators.end(), animator );
-    if ( it != m_animators.end() )
-    {
-        if ( it - m_animators.begin() < m_index )
-            m_index--;
+            if ( b->isAdvancing )
+            {
+                // deleted, when advanceAnimators returns
+                b->window = nullptr;
+                b->animators.clear();
+            }
+            else
+            {
+                delete b;
+            }
 
-        m_animators.erase( it );
+            m_buckets.removeAt( i );
+            break;
+        }
     }
 }
 
 void AnimatorDriver::advanceAnimators( QQuickWindow* window )
 {
-    bool hasAnimators = false;
+    auto b = bucket( window );
+    if ( b == nullptr )
+        return;
+
     bool hasTerminations = false;
+    int advancedCount = 0;
+
+    // all animators of the frame are using the same time
+    const bool isNested = ( m_frameTime >= 0 );
+    if ( !isNested )
+        m_frameTime = m_referenceTime.elapsed();
 
-    for ( m_index = m_animators.size() - 1; m_index >= 0; m_index-- )
+    b->isAdvancing = true;
+
+    // Advancing animators might create/remove animators, what is handled by
+    // appending new animators and leaving gaps for removed ones
+
+    const int count = b->animators.size();
+    for ( int i = 0; i < count && i < b->animators.size(); i++ )
     {
-        // Advancing animators might create/remove animators, what is handled by
-        // adjusting m_index in register/unregister
+        auto animator = b->animators[i];
 
-        auto animator = m_animators[ m_index ];
-        if ( animator->window() == window )
+        if ( animator && animator->isRunning() )
         {
-            hasAnimators = true;
+            animator->update();
+            advancedCount++;
 
-            if ( animator->isRunning() )
-            {
-                animator->update();
-
-                if ( !animator->isRunning() )
-                    hasTerminations = true;
-            }
+            if ( !animator->isRunning() )
+                hasTerminations = true;
         }
     }
 
-    m_index = -1;
+    b->isAdvancing = false;
 
-    if ( !hasAnimators )
+    if ( !isNested )
+        m_frameTime = -1;
+
+    if ( b->window == nullptr )
     {
-        window->disconnect( this );
-        m_windows.removeOne( const_cast< QQuickWindow* >( window ) );
+        // the window has been removed while advancing
+        delete b;
+    }
+    else
+    {
+        compact( b );
+
+        b->statistics.active = b->animators.size();
+        b->statistics.advanced = advancedCount;
+
+        if ( b->animators.isEmpty() )
+            disconnectFrames( b );
     }
 
     Q_EMIT advanced( window );
@@ -398,6 +573,14 @@ QMetaObject::Connection QskAnimator::addAdvanceHandler(
         SIGNAL(advanced(QQuickWindow*)), receiver, method, type );
 }
 
+QskAnimator::FrameStatistics QskAnimator::frameStatistics( const QQuickWindow* window )
+{
+    if ( qskAnimatorDriver )
+        return qskAnimatorDriver->frameStatistics( window );
+
+    return FrameStatistics();
+}
+
 #ifndef QT_NO_DEBUG_STREAM
 
 void QskAnimator::debugStatistics( QDebug debug )
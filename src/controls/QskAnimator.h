@@ -18,6 +18,14 @@ class QDebug;
 class QSK_EXPORT QskAnimator
 {
   public:
+    class FrameStatistics
+    {
+      public:
+        // animators of the window, and how many of them have been advanced
+        int active = 0;
+        int advanced = 0;
+    };
+
     QskAnimator();
     virtual ~QskAnimator();
 
@@ -50,6 +58,9 @@ class QSK_EXPORT QskAnimator
         QObject* receiver, const char* method,
         Qt::ConnectionType type = Qt::AutoConnection );
 
+    // counters of the most recent frame of a window
+    static FrameStatistics frameStatistics( const QQuickWindow* );
+
 #ifndef QT_NO_DEBUG_STREAM
     static void debugStatistics( QDebug );
 #endif
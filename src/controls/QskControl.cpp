@@ -633,6 +633,15 @@ QSizeF QskControl::implicitSizeHint(
         // this one might be cached
         hint = implicitSize();
     }
+    else if ( whichHint == Qt::PreferredSize && childItems().isEmpty() )
+    {
+        /*
+            The hints of controls with children might depend on the
+            children, what is not always indicated by resetImplicitSize().
+            So we cache heightForWidth/widthForHeight of leaf controls only.
+         */
+        hint = d_func()->cachedSizeHint( whichHint, constraint );
+    }
     else
     {
         hint = d_func()->implicitSizeHint( whichHint, constraint );
@@ -854,11 +863,19 @@ void QskControl::itemChange( QQuickItem::ItemChange change,
         }
         case QQuickItem::ItemChildAddedChange:
         {
+            // only the hints of controls without children are cached
+            d_func()->invalidateSizeHints();
+
             if ( autoLayoutChildren() && qskIsAdjustableByLayout( value.item ) )
                 polish();
 
             break;
         }
+        case QQuickItem::ItemChildRemovedChange:
+        {
+            d_func()->invalidateSizeHints();
+            break;
+        }
         case QQuickItem::ItemActiveFocusHasChanged:
         {
             setSkinStateFlag( Focused, hasActiveFocus() );
@@ -6,6 +6,7 @@
 #include "QskControlPrivate.h"
 #include "QskSetup.h"
 #include "QskLayoutMetrics.h"
+#include "QskSizeHintCache.h"
 #include "QskObjectTree.h"
 #include "QskWindow.h"
 
@@ -151,6 +152,7 @@ void qskInheritSection( QskControl* control, QskAspect::Section section )
 
 QskControlPrivate::QskControlPrivate()
     : explicitSizeHints( nullptr )
+    , sizeHintCache( nullptr )
     , sizePolicy( QskSizePolicy::Preferred, QskSizePolicy::Preferred )
     , visiblePlacementPolicy( 0 )
     , hiddenPlacementPolicy( 0 )
@@ -167,10 +169,23 @@ QskControlPrivate::QskControlPrivate()
 QskControlPrivate::~QskControlPrivate()
 {
     delete [] explicitSizeHints;
+    delete sizeHintCache;
+}
+
+void QskControlPrivate::invalidateSizeHints()
+{
+    if ( sizeHintCache )
+        sizeHintCache->invalidate();
 }
 
 void QskControlPrivate::layoutConstraintChanged()
 {
+    /*
+        The cached hints have to be invalidated even when
+        the LayoutRequest events are blocked.
+     */
+    invalidateSizeHints();
+
     if ( !blockLayoutRequestEvents )
     {
         Inherited::layoutConstraintChanged();
@@ -197,6 +212,23 @@ QSizeF QskControlPrivate::implicitSizeHint() const
     return implicitSizeHint( Qt::PreferredSize, QSizeF() );
 }
 
+QSizeF QskControlPrivate::cachedSizeHint(
+    Qt::SizeHint which, const QSizeF& constraint ) const
+{
+    if ( sizeHintCache == nullptr )
+        sizeHintCache = new QskSizeHintCache();
+
+    QSizeF hint;
+
+    if ( !sizeHintCache->lookup( which, constraint, hint ) )
+    {
+        hint = implicitSizeHint( which, constraint );
+        sizeHintCache->insert( which, constraint, hint );
+    }
+
+    return hint;
+}
+
 QSizeF QskControlPrivate::implicitSizeHint(
     Qt::SizeHint which, const QSizeF& constraint ) const
 {
@@ -403,6 +435,12 @@ void QskControlPrivate::resolveSection( QskControl* control )
     }
 }
 
+void QskControlPrivate::resetSizeHintCache( QskControl* control )
+{
+    auto d = static_cast< QskControlPrivate* >( QQuickItemPrivate::get( control ) );
+    d->invalidateSizeHints();
+}
+
 void QskControlPrivate::setPlacementPolicy(
     bool visible, QskPlacementPolicy::Policy policy )
 {
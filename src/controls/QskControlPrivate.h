@@ -10,6 +10,8 @@
 #include "QskControl.h"
 #include "QskQuickItemPrivate.h"
 
+class QskSizeHintCache;
+
 class QskControlPrivate : public QskQuickItemPrivate
 {
     using Inherited = QskQuickItemPrivate;
@@ -21,6 +23,8 @@ class QskControlPrivate : public QskQuickItemPrivate
     static bool inheritSection( QskControl*, QskAspect::Section );
     static void resolveSection( QskControl* );
 
+    static void resetSizeHintCache( QskControl* );
+
   protected:
     QskControlPrivate();
     ~QskControlPrivate() override;
@@ -35,6 +39,9 @@ class QskControlPrivate : public QskQuickItemPrivate
 
     void implicitSizeChanged() override final;
     void layoutConstraintChanged() override final;
+    void invalidateSizeHints() override final;
+
+    QSizeF cachedSizeHint( Qt::SizeHint, const QSizeF& ) const;
 
     bool maybeGesture( QQuickItem*, QEvent* );
 
@@ -46,6 +53,9 @@ class QskControlPrivate : public QskQuickItemPrivate
 
     QSizeF* explicitSizeHints;
 
+    // constrained hints, allocated on demand
+    mutable QskSizeHintCache* sizeHintCache;
+
     QLocale locale;
 
     QskSizePolicy sizePolicy;
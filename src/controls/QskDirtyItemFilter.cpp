@@ -5,12 +5,18 @@
 
 #include "QskDirtyItemFilter.h"
 #include "QskQuickItem.h"
+#include "QskQuickItemPrivate.h"
+
+#include <qpointer.h>
+#include <qvector.h>
 
 QSK_QT_PRIVATE_BEGIN
 #include <private/qquickitem_p.h>
 #include <private/qquickwindow_p.h>
 QSK_QT_PRIVATE_END
 
+#include <memory>
+
 static inline bool qskIsUpdateBlocked( const QQuickItem* item )
 {
     if ( !item->isVisible() )
@@ -19,24 +25,61 @@ static inline bool qskIsUpdateBlocked( const QQuickItem* item )
             return qskItem->testUpdateFlag( QskQuickItem::DeferredUpdate );
     }
 
-#if 0
+    return false;
+}
+
+static inline bool qskIsClippedAway( const QQuickItem* item )
+{
+    const auto qskItem = qobject_cast< const QskQuickItem* >( item );
+    if ( qskItem == nullptr
+        || !qskItem->testUpdateFlag( QskQuickItem::DeferredClippedUpdate ) )
+    {
+        return false;
+    }
+
     /*
-        Blocking items, that are outside the window would be easy,
-        but we have not yet found a performant way to send update notifications
-        when an item enters/leaves the window. TODO ...
+        Only updates of the paint node are deferred. Everything else
+        - f.e transformations - has an effect on the child items,
+        that might be inside of the clip.
      */
-    else if ( const auto control = qskControlCast( item ) )
-    {
-        const QRectF itemRect( item->mapToScene( QPointF() ), item->size() );
-        const QRectF sceneRect( 0, 0, item->window()->width(), item->window()->height() );
+    const auto d = QQuickItemPrivate::get( item );
+    if ( d->dirtyAttributes & ~QQuickItemPrivate::ContentUpdateMask )
+        return false;
+
+    if ( item->clip() )
+        return false;
 
-        return !itemRect.intersects( sceneRect );
+    const auto rect = item->boundingRect();
+    if ( rect.isEmpty() )
+        return false;
+
+    for ( auto clipItem = item->parentItem();
+        clipItem != nullptr; clipItem = clipItem->parentItem() )
+    {
+        if ( clipItem->clip() )
+        {
+            const auto clipRect = clipItem->clipRect();
+            return !item->mapRectToItem( clipItem, rect ).intersects( clipRect );
+        }
     }
-#endif
 
     return false;
 }
 
+static void qskResolvePartialUpdates( QQuickWindow* window )
+{
+    auto d = QQuickWindowPrivate::get( window );
+    for ( auto item = d->dirtyItemList; item != nullptr; )
+    {
+        auto itemPrivate = QQuickItemPrivate::get( item );
+
+        if ( qobject_cast< QskQuickItem* >( item ) )
+            static_cast< QskQuickItemPrivate* >( itemPrivate )->resolvePartialUpdate();
+
+        item = itemPrivate->nextDirtyItem;
+    }
+}
+
 static inline void qskBlockDirty( QQuickItem* item, bool on )
 {
     if ( qskIsUpdateBlocked( item ) )
@@ -67,6 +110,20 @@ namespace
     };
 }
 
+/*
+    Items, that have been taken from the dirty list, because of being
+    outside of their clipping ancestor. Instead of running over the
+    item tree we check them before each synchronization and put them
+    back, when being inside again - f.e. after scrolling.
+
+    The list is only accessed from the scene graph thread of its window.
+ */
+class QskDirtyItemFilter::ClippedItems
+{
+  public:
+    QVector< QPointer< QQuickItem > > items;
+};
+
 QskDirtyItemFilter::QskDirtyItemFilter( QObject* parent )
     : QObject( parent )
 {
@@ -83,6 +140,8 @@ void QskDirtyItemFilter::addWindow( QQuickWindow* window )
 
     m_windows.insert( window );
 
+    const auto clippedItems = std::make_shared< ClippedItems >();
+
     /*
         Depending on the configration the scene graph runs on
         a different thread and we need a direct connection to
@@ -94,16 +153,21 @@ void QskDirtyItemFilter::addWindow( QQuickWindow* window )
      */
 
     connect( window, &QQuickWindow::beforeSynchronizing,
-        window, [ this, window ] { beforeSynchronizing( window ); },
+        window, [ this, window, clippedItems ]
+        { beforeSynchronizing( window, *clippedItems ); },
         Qt::DirectConnection );
 
     connect( window, &QObject::destroyed,
         this, [ this, window ] { m_windows.remove( window ); } );
 }
 
-void QskDirtyItemFilter::beforeSynchronizing( QQuickWindow* window )
+void QskDirtyItemFilter::beforeSynchronizing(
+    QQuickWindow* window, ClippedItems& clippedItems )
 {
     filterDirtyList( window, qskIsUpdateBlocked );
+    filterClippedItems( window, clippedItems );
+
+    qskResolvePartialUpdates( window );
 
     if ( QQuickWindowPrivate::get( window )->renderer == nullptr )
     {
@@ -137,3 +201,56 @@ void QskDirtyItemFilter::filterDirtyList(
         item = nextItem;
     }
 }
+
+void QskDirtyItemFilter::filterClippedItems(
+    QQuickWindow* window, ClippedItems& clippedItems )
+{
+    auto& items = clippedItems.items;
+
+    int count = 0;
+
+    for ( int i = 0; i < items.size(); i++ )
+    {
+        const auto item = items[ i ].data();
+
+        if ( item == nullptr || item->window() != window || !item->isVisible() )
+        {
+            /*
+                Deleted, moved to another window or blocked by
+                DeferredUpdate, what has its own way to catch up.
+             */
+            continue;
+        }
+
+        auto d = QQuickItemPrivate::get( item );
+
+        if ( d->prevDirtyItem || d->dirtyAttributes == 0 )
+        {
+            // updated in the meantime: see below
+            continue;
+        }
+
+        if ( qskIsClippedAway( item ) )
+            items[ count++ ] = items[ i ];
+        else
+            d->addToDirtyList();
+    }
+
+    items.resize( count );
+
+    auto d = QQuickWindowPrivate::get( window );
+    for ( auto item = d->dirtyItemList; item != nullptr; )
+    {
+        auto itemPrivate = QQuickItemPrivate::get( item );
+        auto nextItem = itemPrivate->nextDirtyItem;
+
+        if ( qskIsClippedAway( item ) )
+        {
+            // keeping the dirty attributes for catching up later
+            itemPrivate->removeFromDirtyList();
+            items += item;
+        }
+
+        item = nextItem;
+    }
+}
@@ -28,7 +28,10 @@ class QskDirtyItemFilter : public QObject
         bool ( *isBlocked )( const QQuickItem* ) );
 
   private:
-    void beforeSynchronizing( QQuickWindow* );
+    class ClippedItems;
+
+    void beforeSynchronizing( QQuickWindow*, ClippedItems& );
+    static void filterClippedItems( QQuickWindow*, ClippedItems& );
 
     QSet< QObject* > m_windows;
 };
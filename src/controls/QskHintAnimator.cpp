@@ -129,15 +129,18 @@ void QskHintAnimator::setControl( QskControl* control ) noexcept
 
 void QskHintAnimator::advance( qreal progress )
 {
-    const auto oldValue = currentValue();
-
+    /*
+        Holding a copy of the current value would force the typed
+        tracks of QskVariantAnimator to detach. So we ask it instead
+        of comparing the values here.
+     */
     Inherited::advance( progress );
 
 #if ALIGN_VALUES
     setCurrentValue( qskAligned05( currentValue() ) );
 #endif
 
-    if ( m_control && ( currentValue() != oldValue ) )
+    if ( m_control && isValueChanged() )
     {
         if ( m_updateFlags == QskAnimationHint::UpdateAuto )
         {
@@ -149,7 +152,16 @@ void QskHintAnimator::advance( qreal progress )
                     m_control->polish();
             }
 
-            m_control->update();
+            if ( m_aspect.isColor() || ( m_aspect.isMetric()
+                && m_aspect.metricPrimitive() == QskAspect::Position ) )
+            {
+                // see QskSkinnable::markSubcontrolDirty
+                m_control->markSubcontrolDirty( m_aspect.subControl() );
+            }
+            else
+            {
+                m_control->update();
+            }
         }
         else
         {
@@ -12,12 +12,223 @@
 #include <qstylehints.h>
 
 #include <qmath.h>
+#include <qvector.h>
 
 QSK_SUBCONTROL( QskListView, Cell )
 QSK_SUBCONTROL( QskListView, Text )
 
 QSK_STATE( QskListView, Selected, QskAspect::FirstUserState )
 
+namespace
+{
+    /*
+        A Fenwick tree of the explicit row heights, that allows to
+        calculate positions and to find rows in O(log n). Rows without
+        an explicit height have the default height, what allows
+        to change it without having to rebuild the tree.
+     */
+    class RowHeights
+    {
+      public:
+        inline bool isEmpty() const
+        {
+            return m_explicitCount == 0;
+        }
+
+        void clear()
+        {
+            m_heights.clear();
+            m_sums.clear();
+            m_counts.clear();
+
+            m_explicitCount = 0;
+        }
+
+        bool setHeight( int row, qreal height, int rowCount )
+        {
+            // height < 0: resetting to the default height
+
+            if ( row >= m_heights.size() )
+            {
+                if ( height < 0.0 )
+                    return false;
+
+                resize( qMin( qMax( row + 1, 2 * m_heights.size() ), rowCount ) );
+            }
+
+            const auto oldHeight = m_heights[ row ];
+            if ( oldHeight == height || ( oldHeight < 0.0 && height < 0.0 ) )
+                return false;
+
+            qreal dh = 0.0;
+            int dc = 0;
+
+            if ( oldHeight >= 0.0 )
+            {
+                dh -= oldHeight;
+                dc--;
+            }
+
+            if ( height >= 0.0 )
+            {
+                dh += height;
+                dc++;
+            }
+
+            m_heights[ row ] = height;
+            m_explicitCount += dc;
+
+            for ( int i = row + 1; i <= m_heights.size(); i += i & -i )
+            {
+                m_sums[ i ] += dh;
+                m_counts[ i ] += dc;
+            }
+
+            return true;
+        }
+
+        inline qreal height( int row, qreal defaultHeight ) const
+        {
+            if ( row >= 0 && row < m_heights.size() && m_heights[ row ] >= 0.0 )
+                return m_heights[ row ];
+
+            return defaultHeight;
+        }
+
+        qreal position( int row, qreal defaultHeight ) const
+        {
+            // the accumulated height of the rows [0, row[
+
+            const int n = qBound( 0, row, m_heights.size() );
+
+            qreal sum = 0.0;
+            int count = 0;
+
+            for ( int i = n; i > 0; i -= i & -i )
+            {
+                sum += m_sums[ i ];
+                count += m_counts[ i ];
+            }
+
+            return sum + ( row - count ) * defaultHeight;
+        }
+
+        int rowAt( qreal y, qreal defaultHeight ) const
+        {
+            const int size = m_heights.size();
+
+            int step = 1;
+            while ( 2 * step <= size )
+                step *= 2;
+
+            int pos = 0;
+
+            for ( ; step > 0; step /= 2 )
+            {
+                const int next = pos + step;
+                if ( next <= size )
+                {
+                    const auto length = m_sums[ next ]
+                        + ( step - m_counts[ next ] ) * defaultHeight;
+
+                    if ( length <= y )
+                    {
+                        pos = next;
+                        y -= length;
+                    }
+                }
+            }
+
+            if ( pos < size )
+                return pos;
+
+            // behind the rows of the tree
+            if ( defaultHeight <= 0.0 )
+                return -1;
+
+            return size + qFloor( y / defaultHeight );
+        }
+
+        void insertRows( int row, int count )
+        {
+            if ( row < m_heights.size() && count > 0 )
+            {
+                m_heights.insert( row, count, -1.0 );
+                rebuild();
+            }
+        }
+
+        void removeRows( int row, int count )
+        {
+            if ( row < m_heights.size() && count > 0 )
+            {
+                m_heights.remove( row, qMin( count, m_heights.size() - row ) );
+                rebuild();
+            }
+        }
+
+        void truncate( int rowCount )
+        {
+            // dropping the heights of rows, that do not exist anymore
+
+            if ( rowCount < m_heights.size() )
+            {
+                m_heights.resize( rowCount );
+                rebuild();
+            }
+        }
+
+      private:
+        void resize( int size )
+        {
+            const int oldSize = m_heights.size();
+
+            m_heights.resize( size );
+            for ( int i = oldSize; i < size; i++ )
+                m_heights[ i ] = -1.0;
+
+            rebuild();
+        }
+
+        void rebuild()
+        {
+            // rebuilding the tree in O(n)
+
+            const int size = m_heights.size();
+
+            m_sums.fill( 0.0, size + 1 );
+            m_counts.fill( 0, size + 1 );
+
+            m_explicitCount = 0;
+
+            for ( int i = 1; i <= size; i++ )
+            {
+                const auto h = m_heights[ i - 1 ];
+                if ( h >= 0.0 )
+                {
+                    m_sums[ i ] += h;
+                    m_counts[ i ]++;
+
+                    m_explicitCount++;
+                }
+
+                const int parent = i + ( i & -i );
+                if ( parent <= size )
+                {
+                    m_sums[ parent ] += m_sums[ i ];
+                    m_counts[ parent ] += m_counts[ i ];
+                }
+            }
+        }
+
+        QVector< qreal > m_heights; // < 0: default height
+        QVector< qreal > m_sums;
+        QVector< int > m_counts;
+
+        int m_explicitCount = 0;
+    };
+}
+
 class QskListView::PrivateData
 {
   public:
@@ -34,6 +245,8 @@ class QskListView::PrivateData
     SelectionMode selectionMode : 4;
 
     int selectedRow;
+
+    RowHeights rowHeights;
 };
 
 QskListView::QskListView( QQuickItem* parent )
@@ -143,6 +356,85 @@ QskListView::SelectionMode QskListView::selectionMode() const
     return m_data->selectionMode;
 }
 
+void QskListView::setRowHeight( int row, qreal height )
+{
+    const int count = rowCount();
+    if ( row < 0 || row >= count )
+        return;
+
+    if ( m_data->rowHeights.setHeight( row, qMax( height, 0.0 ), count ) )
+    {
+        updateScrollableSize();
+        update();
+    }
+}
+
+void QskListView::resetRowHeight( int row )
+{
+    if ( row < 0 )
+        return;
+
+    if ( m_data->rowHeights.setHeight( row, -1.0, rowCount() ) )
+    {
+        updateScrollableSize();
+        update();
+    }
+}
+
+void QskListView::resetRowHeights()
+{
+    if ( !m_data->rowHeights.isEmpty() )
+    {
+        m_data->rowHeights.clear();
+
+        updateScrollableSize();
+        update();
+    }
+}
+
+bool QskListView::hasVariableRowHeights() const
+{
+    return !m_data->rowHeights.isEmpty();
+}
+
+qreal QskListView::rowHeightAt( int row ) const
+{
+    return m_data->rowHeights.height( row, rowHeight() );
+}
+
+qreal QskListView::rowPosition( int row ) const
+{
+    if ( m_data->rowHeights.isEmpty() )
+        return row * rowHeight();
+
+    return m_data->rowHeights.position( row, rowHeight() );
+}
+
+int QskListView::rowAt( qreal y ) const
+{
+    if ( y < 0.0 )
+        return -1;
+
+    const auto h = qMax( rowHeight(), 0.0 );
+
+    int row;
+
+    if ( m_data->rowHeights.isEmpty() )
+    {
+        if ( h <= 0.0 )
+            return -1;
+
+        row = qFloor( y / h );
+    }
+    else
+    {
+        // explicit row heights are valid, even when the default height is not
+        row = m_data->rowHeights.rowAt( y, h );
+    }
+
+    return ( row < rowCount() ) ? row : -1;
+}
+
 QskColorFilter QskListView::graphicFilterAt( int row, int col ) const
 {
     Q_UNUSED( row )
@@ -213,7 +505,9 @@ void QskListView::keyPressEvent( QKeyEvent* event )
     {
         auto pos = scrollPos();
 
-        const qreal rowPos = row * rowHeight();
+        const qreal rowPos = rowPosition( row );
+        const qreal rowHeight = rowHeightAt( row );
+
         if ( rowPos < scrollPos().y() )
         {
             pos.setY( rowPos );
@@ -223,9 +517,9 @@ void QskListView::keyPressEvent( QKeyEvent* event )
             const QRectF vr = viewContentsRect();
 
             const double scrolledBottom = scrollPos().y() + vr.height();
-            if ( rowPos + rowHeight() > scrolledBottom )
+            if ( rowPos + rowHeight > scrolledBottom )
             {
-                const double y = rowPos + rowHeight() - vr.height();
+                const double y = rowPos + rowHeight - vr.height();
                 pos.setY( y );
             }
         }
@@ -252,8 +546,8 @@ void QskListView::mousePressEvent( QMouseEvent* event )
         const QRectF vr = viewContentsRect();
         if ( vr.contains( event->pos() ) )
         {
-            const int row = ( event->pos().y() - vr.top() + scrollPos().y() ) / rowHeight();
-            if ( row >= 0 && row < rowCount() )
+            const int row = rowAt( event->pos().y() - vr.top() + scrollPos().y() );
+            if ( row >= 0 )
                 setSelectedRow( row );
 
             return;
@@ -270,19 +564,47 @@ void QskListView::mouseReleaseEvent( QMouseEvent* event )
 
 #ifndef QT_NO_WHEELEVENT
 
-static qreal qskAlignedToRows( const qreal y0, qreal dy,
-    qreal rowHeight, qreal viewHeight )
+static qreal qskAlignedToRows( const QskListView* listView,
+    const qreal y0, qreal dy, qreal viewHeight )
 {
     qreal y = y0 - dy;
 
+    if ( !listView->hasVariableRowHeights() )
+    {
+        const auto rowHeight = listView->rowHeight();
+
+        if ( dy > 0 )
+        {
+            y = qFloor( y / rowHeight ) * rowHeight;
+        }
+        else
+        {
+            y += viewHeight;
+            y = qCeil( y / rowHeight ) * rowHeight;
+            y -= viewHeight;
+        }
+
+        return y;
+    }
+
     if ( dy > 0 )
     {
-        y = qFloor( y / rowHeight ) * rowHeight;
+        const auto row = listView->rowAt( y );
+        if ( row >= 0 )
+            y = listView->rowPosition( row );
     }
     else
     {
         y += viewHeight;
-        y = qCeil( y / rowHeight ) * rowHeight;
+
+        const auto row = listView->rowAt( y );
+        if ( row >= 0 )
+        {
+            const auto rowPos = listView->rowPosition( row );
+            if ( rowPos < y )
+                y = rowPos + listView->rowHeightAt( row );
+        }
+
         y -= viewHeight;
     }
 
@@ -329,7 +651,7 @@ QPointF QskListView::scrollOffset( const QWheelEvent* event ) const
         dy *= offset.y(); // multiplied by the wheelsteps
 
         // aligning rows that enter the view
-        dy = qskAlignedToRows( y0, dy, rowHeight, viewHeight );
+        dy = qskAlignedToRows( this, y0, dy, viewHeight );
 
         offset.setY( y0 - dy );
     }
@@ -341,9 +663,23 @@ QPointF QskListView::scrollOffset( const QWheelEvent* event ) const
 
 #endif
 
+void QskListView::rowsInserted( int row, int count )
+{
+    if ( row >= 0 )
+        m_data->rowHeights.insertRows( row, count );
+}
+
+void QskListView::rowsRemoved( int row, int count )
+{
+    if ( row >= 0 )
+        m_data->rowHeights.removeRows( row, count );
+}
+
 void QskListView::updateScrollableSize()
 {
-    const double h = rowCount() * rowHeight();
+    m_data->rowHeights.truncate( rowCount() );
+
+    const double h = rowPosition( rowCount() );
 
     qreal w = 0.0;
     for ( int col = 0; col < columnCount(); col++ )
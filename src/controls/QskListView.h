@@ -65,6 +65,29 @@ class QSK_EXPORT QskListView : public QskScrollView
     virtual qreal columnWidth( int col ) const = 0;
     virtual qreal rowHeight() const = 0;
 
+    /*
+        By default all rows have the same height: rowHeight(). Rows
+        with a different height can be set explicitly. Positions are
+        looked up in O(log n) from an index of the explicit heights.
+
+        Explicit heights are stored by row: when inserting or removing
+        rows, derived classes have to call rowsInserted()/rowsRemoved()
+        to keep them attached to the right rows. Heights of rows behind
+        rowCount() are dropped by updateScrollableSize().
+     */
+    void setRowHeight( int row, qreal height );
+    void resetRowHeight( int row );
+    void resetRowHeights();
+
+    bool hasVariableRowHeights() const;
+    qreal rowHeightAt( int row ) const;
+
+    // the y coordinate of the row, relative to the scrollable area
+    qreal rowPosition( int row ) const;
+
+    // the row at the y coordinate or -1
+    Q_INVOKABLE int rowAt( qreal y ) const;
+
     Q_INVOKABLE virtual QVariant valueAt( int row, int col ) const = 0;
 
 #if 1
@@ -95,6 +118,9 @@ class QSK_EXPORT QskListView : public QskScrollView
 
     void updateScrollableSize();
 
+    void rowsInserted( int row, int count );
+    void rowsRemoved( int row, int count );
+
     void componentComplete() override;
 
   private:
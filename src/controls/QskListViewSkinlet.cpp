@@ -12,6 +12,7 @@
 #include "QskSkinStateChanger.h"
 
 #include <qmath.h>
+#include <qvector.h>
 #include <qsgnode.h>
 #include <qsgsimplerectnode.h>
 #include <qtransform.h>
@@ -19,8 +20,7 @@
 class QskListViewNode final : public QSGTransformNode
 {
   public:
-    inline QskListViewNode( int columnCount )
-        : m_columnCount( columnCount )
+    inline QskListViewNode()
     {
         m_backgroundNode.setFlag( QSGNode::OwnedByParent, false );
         appendChildNode( &m_backgroundNode );
@@ -39,10 +39,12 @@ class QskListViewNode final : public QSGTransformNode
         return &m_foregroundNode;
     }
 
-    inline void resetRows( int rowMin, int rowMax )
+    inline void resetCells( int rowMin, int rowMax, int colMin, int colMax )
     {
         m_rowMin = rowMin;
         m_rowMax = rowMax;
+        m_colMin = colMin;
+        m_colMax = colMax;
     }
 
     inline int rowMin() const
@@ -55,35 +57,176 @@ class QskListViewNode final : public QSGTransformNode
         return m_rowMax;
     }
 
+    inline int colMin() const
+    {
+        return m_colMin;
+    }
+
+    inline int colMax() const
+    {
+        return m_colMax;
+    }
+
     inline bool intersects( int rowMin, int rowMax ) const
     {
         return ( rowMin <= m_rowMax ) && ( rowMax >= m_rowMin );
     }
 
-    inline int nodeCount() const
+    inline int visibleColumnCount() const
     {
-        return ( m_rowMin >= 0 ) ? ( m_rowMax - m_rowMin + 1 ) * m_columnCount : 0;
+        return ( m_colMin >= 0 ) ? ( m_colMax - m_colMin + 1 ) : 0;
     }
 
-    inline int columnCount() const
+    inline int nodeCount() const
     {
-        return m_columnCount;
+        return ( m_rowMin >= 0 ) ? ( m_rowMax - m_rowMin + 1 ) * visibleColumnCount() : 0;
     }
 
     inline void invalidate()
     {
         m_rowMin = m_rowMax = -1;
+        m_colMin = m_colMax = -1;
     }
 
   private:
-    int m_columnCount;
     int m_rowMin = -1;
     int m_rowMax = -1;
+    int m_colMin = -1;
+    int m_colMax = -1;
 
     QSGNode m_backgroundNode;
     QSGNode m_foregroundNode;
 };
 
+static void qskVisibleRows( const QskListView* listView,
+    qreal y, qreal height, int& rowMin, int& rowMax )
+{
+    // O(log n) for variable row heights
+    rowMin = listView->rowAt( qMax( y, 0.0 ) );
+
+    if ( rowMin < 0 )
+    {
+        // scrolled beyond the content: empty range
+        rowMin = listView->rowCount();
+        rowMax = rowMin - 1;
+
+        return;
+    }
+
+    rowMax = listView->rowAt( y + height );
+    if ( rowMax < 0 )
+        rowMax = listView->rowCount() - 1;
+}
+
+static void qskVisibleColumns( const QskListView* listView,
+    qreal x, qreal width, int& colMin, int& colMax, qreal& xMin )
+{
+    const int count = listView->columnCount();
+
+    colMin = 0;
+    xMin = 0.0;
+
+    qreal w = listView->columnWidth( 0 );
+
+    while ( ( colMin < count - 1 ) && ( xMin + w <= x ) )
+    {
+        xMin += w;
+        w = listView->columnWidth( ++colMin );
+    }
+
+    colMax = colMin;
+
+    for ( qreal xMax = xMin + w; ( colMax < count - 1 ) && ( xMax < x + width ); )
+        xMax += listView->columnWidth( ++colMax );
+}
+
+static void qskRearrangeCellNodes( QskListViewNode* listViewNode,
+    int rowMin, int rowMax, int colMin, int colMax )
+{
+    /*
+        The visible columns have changed: nodes of cells, that are still
+        visible, stay with their cell, while the nodes of the cells leaving
+        the viewport are recycled for those becoming visible.
+     */
+
+    auto parentNode = listViewNode->foregroundNode();
+
+    const int oldRowMin = listViewNode->rowMin();
+    const int oldColMin = listViewNode->colMin();
+    const int oldColCount = listViewNode->visibleColumnCount();
+
+    QVector< QSGNode* > oldNodes;
+    oldNodes.reserve( listViewNode->nodeCount() );
+
+    while ( auto node = parentNode->firstChild() )
+    {
+        parentNode->removeChildNode( node );
+        oldNodes += node;
+    }
+
+    const auto oldIndex =
+        [&]( int row, int col ) -> int
+        {
+            if ( row < oldRowMin || row > listViewNode->rowMax()
+                || col < oldColMin || col > listViewNode->colMax() )
+            {
+                return -1;
+            }
+
+            return ( row - oldRowMin ) * oldColCount + ( col - oldColMin );
+        };
+
+    QVector< QSGNode* > newNodes;
+    newNodes.reserve( ( rowMax - rowMin + 1 ) * ( colMax - colMin + 1 ) );
+
+    for ( int row = rowMin; row <= rowMax; row++ )
+    {
+        for ( int col = colMin; col <= colMax; col++ )
+        {
+            QSGNode* node = nullptr;
+
+            const int index = oldIndex( row, col );
+            if ( index >= 0 )
+            {
+                node = oldNodes[ index ];
+                oldNodes[ index ] = nullptr;
+            }
+
+            newNodes += node;
+        }
+    }
+
+    // the remaining old nodes can be recycled
+    int recycled = 0;
+
+    for ( auto& node : newNodes )
+    {
+        if ( node == nullptr )
+        {
+            while ( recycled < oldNodes.size() && oldNodes[ recycled ] == nullptr )
+                recycled++;
+
+            if ( recycled < oldNodes.size() )
+            {
+                node = oldNodes[ recycled ];
+                oldNodes[ recycled ] = nullptr;
+            }
+            else
+            {
+                // a placeholder, that will be replaced by a cell node
+                node = new QSGTransformNode();
+            }
+        }
+
+        parentNode->appendChildNode( node );
+    }
+
+    for ( auto node : qAsConst( oldNodes ) )
+        delete node;
+
+    listViewNode->resetCells( rowMin, rowMax, colMin, colMax );
+}
+
 QskListViewSkinlet::QskListViewSkinlet( QskSkin* skin )
     : Inherited( skin )
 {
@@ -98,7 +241,7 @@ QSGNode* QskListViewSkinlet::updateContentsNode(
 
     auto listViewNode = static_cast< QskListViewNode* >( node );
     if ( listViewNode == nullptr )
-        listViewNode = new QskListViewNode( listView->columnCount() );
+        listViewNode = new QskListViewNode();
 
     QTransform transform;
     transform.translate( -listView->scrollPos().x(), -listView->scrollPos().y() );
@@ -115,15 +258,11 @@ void QskListViewSkinlet::updateBackgroundNodes(
 {
     QSGNode* backgroundNode = listViewNode->backgroundNode();
 
-    const qreal cellHeight = listView->rowHeight();
     const QRectF viewRect = listView->viewContentsRect();
-
     const QPointF scrolledPos = listView->scrollPos();
-    const int rowMin = qFloor( scrolledPos.y() / cellHeight );
 
-    int rowMax = qCeil( ( scrolledPos.y() + viewRect.height() ) / cellHeight );
-    if ( rowMax >= listView->rowCount() )
-        rowMax = listView->rowCount() - 1;
+    int rowMin, rowMax;
+    qskVisibleRows( listView, scrolledPos.y(), viewRect.height(), rowMin, rowMax );
 
     const int rowSelected = listView->selectedRow();
     const double x0 = viewRect.left() + scrolledPos.x();
@@ -151,7 +290,8 @@ void QskListViewSkinlet::updateBackgroundNodes(
                     backgroundNode->appendChildNode( rowNode );
                 }
 
-                rowNode->setRect( x0, y0 + row * cellHeight, viewRect.width(), cellHeight );
+                rowNode->setRect( x0, y0 + listView->rowPosition( row ),
+                    viewRect.width(), listView->rowHeightAt( row ) );
                 rowNode->setColor( color );
 
                 rowNode = static_cast< QSGSimpleRectNode* >( rowNode->nextSibling() );
@@ -172,7 +312,8 @@ void QskListViewSkinlet::updateBackgroundNodes(
             backgroundNode->appendChildNode( rowNode );
         }
 
-        rowNode->setRect( x0, y0 + rowSelected * cellHeight, viewRect.width(), cellHeight );
+        rowNode->setRect( x0, y0 + listView->rowPosition( rowSelected ),
+            viewRect.width(), listView->rowHeightAt( rowSelected ) );
         rowNode->setColor( color );
 
         rowNode = static_cast< QSGSimpleRectNode* >( rowNode->nextSibling() );
@@ -204,21 +345,23 @@ void QskListViewSkinlet::updateForegroundNodes(
     const auto cr = listView->viewContentsRect();
     const auto scrolledPos = listView->scrollPos();
 
-    const int rowMin = qFloor( scrolledPos.y() / listView->rowHeight() );
+    int rowMin, rowMax;
+    qskVisibleRows( listView, scrolledPos.y(), cr.height(), rowMin, rowMax );
 
-    int rowMax = rowMin + qCeil( cr.height() / listView->rowHeight() );
-    if ( rowMax >= listView->rowCount() )
-        rowMax = listView->rowCount() - 1;
+    int colMin, colMax;
+    qreal xMin;
+    qskVisibleColumns( listView, scrolledPos.x(), cr.width(), colMin, colMax, xMin );
 
-#if 1
-    // should be optimized for visible columns only
-    const int colMin = 0;
-    const int colMax = listView->columnCount() - 1;
-#endif
+    const int colCount = colMax - colMin + 1;
 
     bool forwards = true;
 
-    if ( listViewNode->intersects( rowMin, rowMax ) )
+    if ( ( colMin != listViewNode->colMin() || colMax != listViewNode->colMax() )
+        && listViewNode->nodeCount() > 0 )
+    {
+        qskRearrangeCellNodes( listViewNode, rowMin, rowMax, colMin, colMax );
+    }
+    else if ( listViewNode->intersects( rowMin, rowMax ) )
     {
         /*
             We try to avoid reallcations when scrolling, by reusing
@@ -232,7 +375,7 @@ void QskListViewSkinlet::updateForegroundNodes(
             // usually scrolling down
             for ( int row = listViewNode->rowMin(); row < rowMin; row++ )
             {
-                for ( int col = 0; col < listView->columnCount(); col++ )
+                for ( int col = 0; col < colCount; col++ )
                 {
                     QSGNode* childNode = parentNode->firstChild();
                     parentNode->removeChildNode( childNode );
@@ -245,7 +388,7 @@ void QskListViewSkinlet::updateForegroundNodes(
             // usually scrolling up
             for ( int row = rowMax; row < listViewNode->rowMax(); row++ )
             {
-                for ( int col = 0; col < listView->columnCount(); col++ )
+                for ( int col = 0; col < colCount; col++ )
                 {
                     QSGNode* childNode = parentNode->lastChild();
                     parentNode->removeChildNode( childNode );
@@ -261,12 +404,11 @@ void QskListViewSkinlet::updateForegroundNodes(
     // finally putting the nodes into their position
     auto node = parentNode->firstChild();
 
-    const qreal rowHeight = listView->rowHeight();
-    qreal y = cr.top() + rowMin * rowHeight;
+    qreal y = cr.top() + listView->rowPosition( rowMin );
 
     for ( int row = rowMin; row <= rowMax; row++ )
     {
-        qreal x = cr.left();
+        qreal x = cr.left() + xMin;
 
         for ( int col = colMin; col <= colMax; col++ )
         {
@@ -282,10 +424,10 @@ void QskListViewSkinlet::updateForegroundNodes(
             x += listView->columnWidth( col );
         }
 
-        y += rowHeight;
+        y += listView->rowHeightAt( row );
     }
 
-    listViewNode->resetRows( rowMin, rowMax );
+    listViewNode->resetCells( rowMin, rowMax, colMin, colMax );
 }
 
 void QskListViewSkinlet::updateVisibleForegroundNodes(
@@ -308,9 +450,9 @@ void QskListViewSkinlet::updateVisibleForegroundNodes(
 
         for ( int row = rowMin; row <= rowMax; row++ )
         {
-            const qreal h = listView->rowHeight() - ( margins.top() + margins.bottom() );
+            const qreal h = listView->rowHeightAt( row ) - ( margins.top() + margins.bottom() );
 
-            for ( int col = 0; col < listView->columnCount(); col++ )
+            for ( int col = colMin; col <= colMax; col++ )
             {
                 const qreal w = listView->columnWidth( col ) - ( margins.left() + margins.right() );
 
@@ -331,9 +473,9 @@ void QskListViewSkinlet::updateVisibleForegroundNodes(
 
         for ( int row = rowMax; row >= rowMin; row-- )
         {
-            const qreal h = listView->rowHeight() - ( margins.top() + margins.bottom() );
+            const qreal h = listView->rowHeightAt( row ) - ( margins.top() + margins.bottom() );
 
-            for ( int col = listView->columnCount() - 1; col >= 0; col-- )
+            for ( int col = colMax; col >= colMin; col-- )
             {
                 const qreal w = listView->columnWidth( col ) - ( margins.left() + margins.right() );
 
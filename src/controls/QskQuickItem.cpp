@@ -47,6 +47,10 @@ static inline void qskApplyUpdateFlags(
     d->applyUpdateFlags( flags );
 }
 
+// the flags, that need to have QskDirtyItemFilter being installed
+static const int qskFilteredUpdateFlags =
+    QskQuickItem::DeferredUpdate | QskQuickItem::DeferredClippedUpdate;
+
 static inline void qskFilterWindow( QQuickWindow* window )
 {
     if ( window == nullptr )
@@ -166,7 +170,7 @@ QskQuickItem::QskQuickItem( QskQuickItemPrivate& dd, QQuickItem* parent )
 {
     setFlag( QQuickItem::ItemHasContents, true );
 
-    if ( dd.updateFlags & QskQuickItem::DeferredUpdate )
+    if ( dd.updateFlags & qskFilteredUpdateFlags )
         qskFilterWindow( window() );
 
     qskRegistry->insert( this );
@@ -422,6 +426,33 @@ bool QskQuickItem::isUpdateNodeScheduled() const
            ( d->flags & QQuickItem::ItemHasContents );
 }
 
+void QskQuickItem::updatePartially()
+{
+    Q_D( QskQuickItem );
+
+    if ( !( d->flags & QQuickItem::ItemHasContents ) )
+        return;
+
+    d->partialUpdate = true;
+
+    /*
+        QQuickItem::update is not virtual, so we can't be aware of
+        all other updates. Instead of QQuickItemPrivate::Content we set
+        another bit, that also results in calling updatePaintNode. Any other
+        update sets the Content bit and before synchronizing the scene graph
+        QskDirtyItemFilter downgrades the item to a complete update.
+     */
+    d->dirty( QQuickItemPrivate::Antialiasing );
+
+    qskFilterWindow( window() );
+}
+
+bool QskQuickItem::isUpdatePartial() const
+{
+    Q_D( const QskQuickItem );
+    return d->partialUpdate && !d->fullUpdate;
+}
+
 bool QskQuickItem::isInitiallyPainted() const
 {
     return d_func()->initiallyPainted;
@@ -522,6 +553,21 @@ void QskQuickItem::applyUpdateFlag( UpdateFlag flag, bool on )
 
             break;
         }
+        case QskQuickItem::DeferredClippedUpdate:
+        {
+            if ( on )
+            {
+                qskFilterWindow( window() );
+            }
+            else
+            {
+                // the item might have been taken from the dirty list
+                if ( d->dirtyAttributes )
+                    update();
+            }
+
+            break;
+        }
         case QskQuickItem::DeferredPolish:
         {
             if ( !on && d->blockedPolish )
@@ -569,6 +615,8 @@ void QskQuickItem::resetImplicitSize()
 {
     Q_D( QskQuickItem );
 
+    d->invalidateSizeHints();
+
     if ( d->updateFlags & QskQuickItem::DeferredLayout )
     {
         d->blockedImplicitSize = true;
@@ -708,7 +756,7 @@ void QskQuickItem::itemChange( QQuickItem::ItemChange change,
             if ( changeData.window )
             {
                 Q_D( const QskQuickItem );
-                if ( d->updateFlags & QskQuickItem::DeferredUpdate )
+                if ( d->updateFlags & qskFilteredUpdateFlags )
                     qskFilterWindow( changeData.window );
             }
 
@@ -832,10 +880,16 @@ void QskQuickItem::itemChange( QQuickItem::ItemChange change,
             break;
         }
 
+        case QQuickItem::ItemAntialiasingHasChanged:
+        {
+            // the dirty bit is also used for partial updates
+            d_func()->fullUpdate = true;
+            break;
+        }
+
         case QQuickItem::ItemOpacityHasChanged:
         case QQuickItem::ItemActiveFocusHasChanged:
         case QQuickItem::ItemRotationHasChanged:
-        case QQuickItem::ItemAntialiasingHasChanged:
         case QQuickItem::ItemDevicePixelRatioHasChanged:
         {
             break;
@@ -864,10 +918,13 @@ void QskQuickItem::geometryChange(
     Inherited::geometryChange( newGeometry, oldGeometry );
 #endif
 
-    Q_D( const QskQuickItem );
-    if ( !d->polishScheduled && d->polishOnResize )
+    Q_D( QskQuickItem );
+
+    if ( newGeometry.size() != oldGeometry.size() )
     {
-        if ( newGeometry.size() != oldGeometry.size() )
+        d->fullUpdate = true;
+
+        if ( !d->polishScheduled && d->polishOnResize )
             polish();
     }
 
@@ -948,7 +1005,14 @@ QSGNode* QskQuickItem::updatePaintNode( QSGNode* node, UpdatePaintNodeData* data
         d->clearPreviousNodes = false;
     }
 
-    return updateItemPaintNode( node );
+    if ( node == nullptr )
+        d->fullUpdate = true;
+
+    node = updateItemPaintNode( node );
+
+    d->fullUpdate = d->partialUpdate = false;
+
+    return node;
 }
 
 QSGNode* QskQuickItem::updateItemPaintNode( QSGNode* node )
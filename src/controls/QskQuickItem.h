@@ -43,8 +43,14 @@ class QSK_EXPORT QskQuickItem : public QQuickItem
         CleanupOnVisibility     =  1 << 3,
 
         PreferRasterForTextures =  1 << 4,
+        AsynchronousTextures    =  1 << 5,
+        AtlasTextures           =  1 << 6,
 
-        DebugForceBackground    =  1 << 7
+        DebugForceBackground    =  1 << 7,
+
+        VectorGraphics          =  1 << 8,
+
+        DeferredClippedUpdate   =  1 << 9
     };
 
     Q_ENUM( UpdateFlag )
@@ -95,6 +101,16 @@ class QSK_EXPORT QskQuickItem : public QQuickItem
 
     bool isPolishScheduled() const;
     bool isUpdateNodeScheduled() const;
+
+    /*
+        An update, that affects only parts of the scene graph nodes.
+        As long as no other update ( f.e. QQuickItem::update ) has been
+        requested before updatePaintNode is called, the implementation
+        might limit itself to revisit those parts only.
+     */
+    void updatePartially();
+    bool isUpdatePartial() const;
+
     bool isInitiallyPainted() const;
 
     bool maybeUnresized() const;
@@ -19,6 +19,8 @@ QskQuickItemPrivate::QskQuickItemPrivate()
     , blockedPolish( false )
     , blockedImplicitSize( true )
     , clearPreviousNodes( false )
+    , fullUpdate( true )
+    , partialUpdate( false )
     , initiallyPainted( false )
 {
     if ( updateFlags & QskQuickItem::DeferredLayout )
@@ -55,6 +57,20 @@ void QskQuickItemPrivate::mirrorChange()
     qskSendEventTo( q_func(), QEvent::LayoutDirectionChange );
 }
 
+void QskQuickItemPrivate::resolvePartialUpdate()
+{
+    // see QskQuickItem::updatePartially
+
+    if ( partialUpdate && !fullUpdate )
+    {
+        const quint32 mask = QQuickItemPrivate::ContentUpdateMask
+            & ~QQuickItemPrivate::Antialiasing;
+
+        if ( dirtyAttributes & mask )
+            fullUpdate = true;
+    }
+}
+
 void QskQuickItemPrivate::applyUpdateFlags( QskQuickItem::UpdateFlags flags )
 {
     /*
@@ -69,8 +85,8 @@ void QskQuickItemPrivate::applyUpdateFlags( QskQuickItem::UpdateFlags flags )
 
     Q_Q( QskQuickItem );
 
-    Q_STATIC_ASSERT( sizeof( updateFlags ) == 1 );
-    for ( uint i = 0; i < 8; i++ )
+    Q_STATIC_ASSERT( sizeof( updateFlags ) == 2 );
+    for ( uint i = 0; i < 16; i++ )
     {
         const auto flag = static_cast< QskQuickItem::UpdateFlag >( 1 << i );
 
@@ -93,6 +109,10 @@ void QskQuickItemPrivate::implicitSizeChanged()
     layoutConstraintChanged();
 }
 
+void QskQuickItemPrivate::invalidateSizeHints()
+{
+}
+
 qreal QskQuickItemPrivate::getImplicitWidth() const
 {
     if ( blockedImplicitSize )
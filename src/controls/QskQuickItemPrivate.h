@@ -24,9 +24,13 @@ class QskQuickItemPrivate : public QQuickItemPrivate
   public:
     void applyUpdateFlags( QskQuickItem::UpdateFlags );
 
+    // called for the items of the dirty list before synchronizing
+    void resolvePartialUpdate();
+
   protected:
     virtual void layoutConstraintChanged();
     virtual void implicitSizeChanged();
+    virtual void invalidateSizeHints();
 
   private:
 
@@ -47,8 +51,8 @@ class QskQuickItemPrivate : public QQuickItemPrivate
   private:
     Q_DECLARE_PUBLIC( QskQuickItem )
 
-    quint8 updateFlags;
-    quint8 updateFlagsMask;
+    quint16 updateFlags;
+    quint16 updateFlagsMask;
 
     bool polishOnResize : 1;
 
@@ -56,6 +60,10 @@ class QskQuickItemPrivate : public QQuickItemPrivate
     bool blockedImplicitSize : 1;
     bool clearPreviousNodes : 1;
 
+    // see QskQuickItem::isUpdatePartial
+    bool fullUpdate : 1;
+    bool partialUpdate : 1;
+
     bool initiallyPainted : 1;
 };
 
@@ -6,6 +6,8 @@
 #include "QskSetup.h"
 #include "QskControl.h"
 #include "QskControlPrivate.h"
+#include "QskGraphic.h"
+#include "QskGraphicProvider.h"
 #include "QskGraphicProviderMap.h"
 #include "QskSkin.h"
 #include "QskSkinManager.h"
@@ -13,7 +15,10 @@
 
 #include <qguiapplication.h>
 #include <qpointer.h>
+#include <qrunnable.h>
 #include <qstylehints.h>
+#include <qthreadpool.h>
+#include <qurl.h>
 
 QskSetup* QskSetup::s_instance = nullptr;
 
@@ -37,9 +42,21 @@ static inline const QskQuickItem::UpdateFlags qskEnvironmentUpdateFlags()
     if ( qskHasEnvironment( "QSK_PREFER_RASTER" ) )
         flags |= QskQuickItem::PreferRasterForTextures;
 
+    if ( qskHasEnvironment( "QSK_ASYNC_TEXTURES" ) )
+        flags |= QskQuickItem::AsynchronousTextures;
+
+    if ( qskHasEnvironment( "QSK_ATLAS_TEXTURES" ) )
+        flags |= QskQuickItem::AtlasTextures;
+
     if ( qskHasEnvironment( "QSK_FORCE_BACKGROUND" ) )
         flags |= QskQuickItem::DebugForceBackground;
 
+    if ( qskHasEnvironment( "QSK_VECTOR_GRAPHICS" ) )
+        flags |= QskQuickItem::VectorGraphics;
+
+    if ( qskHasEnvironment( "QSK_DEFERRED_CLIPPED_UPDATE" ) )
+        flags |= QskQuickItem::DeferredClippedUpdate;
+
     return flags;
 }
 
@@ -70,6 +87,29 @@ static void qskApplicationFilter()
     QCoreApplication::instance()->installEventFilter( QskSetup::instance() );
 }
 
+namespace
+{
+    class WarmUpJob final : public QRunnable
+    {
+      public:
+        WarmUpJob( const QskGraphicProvider* provider, const QString& id )
+            : m_provider( provider )
+            , m_id( id )
+        {
+        }
+
+        void run() override
+        {
+            // loading and parsing the graphic fills the cache of the provider
+            ( void ) m_provider->requestGraphic( m_id );
+        }
+
+      private:
+        const QskGraphicProvider* m_provider;
+        const QString m_id;
+    };
+}
+
 Q_CONSTRUCTOR_FUNCTION( qskApplicationHook )
 Q_COREAPP_STARTUP_FUNCTION( qskApplicationFilter )
 
@@ -86,6 +126,8 @@ class QskSetup::PrivateData
 
     QskGraphicProviderMap graphicProviders;
     QskQuickItem::UpdateFlags itemUpdateFlags;
+
+    QThreadPool warmUpPool;
 };
 
 QskSetup::QskSetup()
@@ -95,6 +137,8 @@ QskSetup::QskSetup()
 
 QskSetup::~QskSetup()
 {
+    waitForWarmUp();
+
     s_instance = nullptr; // we might be destroyed from Qml !
 }
 
@@ -166,6 +210,9 @@ QskSkin* QskSetup::setSkin( const QString& skinName )
 
     const auto oldSkin = m_data->skin;
 
+    // pending jobs might use graphic providers of the old skin
+    waitForWarmUp();
+
     m_data->skin = skin;
     m_data->skinName = skinName;
 
@@ -201,6 +248,9 @@ QskSkin* QskSetup::skin()
 
 void QskSetup::addGraphicProvider( const QString& providerId, QskGraphicProvider* provider )
 {
+    // a previous provider gets deleted, but might be in use by warm up jobs
+    waitForWarmUp();
+
     m_data->graphicProviders.insert( providerId, provider );
 }
 
@@ -216,6 +266,50 @@ QskGraphicProvider* QskSetup::graphicProvider( const QString& providerId ) const
     return m_data->graphicProviders.provider( providerId );
 }
 
+void QskSetup::warmUp( const QList< QUrl >& graphics,
+    const QList< const QMetaObject* >& controls )
+{
+    /*
+        Skinlets are created lazily, when a control of its type is
+        painted for the first time. Creating them is not thread safe,
+        but cheap and we can do it here.
+     */
+    if ( !controls.isEmpty() )
+    {
+        auto skin = this->skin();
+
+        for ( const auto metaObject : controls )
+            ( void ) skin->skinlet( metaObject );
+    }
+
+    /*
+        Loading graphics is expensive and happens on a thread pool.
+        The providers are resolved here as the lookup is not thread safe,
+        while QskGraphicProvider::requestGraphic is.
+     */
+    for ( const auto& url : graphics )
+    {
+        // the same decomposition of the url as in Qsk::loadGraphic
+
+        QString id = url.toString( QUrl::RemoveScheme |
+            QUrl::RemoveAuthority | QUrl::NormalizePathSegments );
+
+        if ( id.startsWith( QLatin1Char( '/' ) ) )
+            id = id.mid( 1 );
+
+        if ( id.isEmpty() )
+            continue;
+
+        if ( const auto provider = graphicProvider( url.host() ) )
+            m_data->warmUpPool.start( new WarmUpJob( provider, id ) );
+    }
+}
+
+void QskSetup::waitForWarmUp()
+{
+    m_data->warmUpPool.waitForDone();
+}
+
 bool QskSetup::eventFilter( QObject* object, QEvent* event )
 {
     if ( auto control = qskControlCast( object ) )
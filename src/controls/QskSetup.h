@@ -15,6 +15,7 @@
 class QskSkin;
 class QQuickItem;
 class QskGraphicProvider;
+class QUrl;
 
 #if defined( qskSetup )
 #undef qskSetup
@@ -46,6 +47,11 @@ class QSK_EXPORT QskSetup : public QObject
     void addGraphicProvider( const QString& providerId, QskGraphicProvider* );
     QskGraphicProvider* graphicProvider( const QString& providerId ) const;
 
+    void warmUp( const QList< QUrl >& graphics,
+        const QList< const QMetaObject* >& controls = QList< const QMetaObject* >() );
+
+    void waitForWarmUp();
+
     static void setup();
     static void cleanup();
 
@@ -5,19 +5,15 @@
 
 #include "QskSimpleListBox.h"
 #include "QskAspect.h"
-#include "QskFunctions.h"
-
-#include <qfontmetrics.h>
+#include "QskTextCache.h"
 
 static inline qreal qskMaxWidth(
     const QFont& font, const QStringList& list )
 {
-    const QFontMetricsF fm( font );
-
     qreal max = 0.0;
     for ( int i = 0; i < list.size(); i++ )
     {
-        const qreal w = qskHorizontalAdvance( fm, list[ i ] );
+        const qreal w = QskTextCache::horizontalAdvance( font, list[ i ] );
         if ( w > max )
             max = w;
     }
@@ -120,6 +116,8 @@ void QskSimpleListBox::insert( const QStringList& list, int index )
         // is there no better way ???
         for ( int i = 0; i < list.size(); i++ )
             m_data->entries.insert( index + i, list[ i ] );
+
+        rowsInserted( index, list.size() );
     }
 
     propagateEntries();
@@ -147,15 +145,20 @@ void QskSimpleListBox::insert( const QString& text, int index )
 {
     if ( m_data->columnWidthHint <= 0.0 )
     {
-        const auto w = qskHorizontalAdvance( effectiveFont( Cell ), text );
+        const auto w = QskTextCache::horizontalAdvance( effectiveFont( Cell ), text );
         if ( w > m_data->maxTextWidth )
             m_data->maxTextWidth = w;
     }
 
     if ( index < 0 )
+    {
         m_data->entries.append( text );
+    }
     else
+    {
         m_data->entries.insert( index, text );
+        rowsInserted( index, 1 );
+    }
 
     propagateEntries();
 }
@@ -169,13 +172,14 @@ void QskSimpleListBox::removeAt( int index )
 
     if ( m_data->columnWidthHint <= 0.0 )
     {
-        const auto w = qskHorizontalAdvance( effectiveFont( Cell ), entries[ index ] );
+        const auto w = QskTextCache::horizontalAdvance( effectiveFont( Cell ), entries[ index ] );
         if ( w >= m_data->maxTextWidth )
             m_data->maxTextWidth = qskMaxWidth( effectiveFont( Text ), entries );
     }
     else
     {
         entries.removeAt( index );
+        rowsRemoved( index, 1 );
     }
 
     propagateEntries();
@@ -206,6 +210,8 @@ void QskSimpleListBox::removeBulk( int from, int to )
     for ( int i = to; i >= from; i-- )
         m_data->entries.removeAt( i );
 
+    rowsRemoved( from, to - from + 1 );
+
     if ( m_data->columnWidthHint <= 0.0 )
         m_data->maxTextWidth = qskMaxWidth( effectiveFont( Text ), m_data->entries );
 
@@ -0,0 +1,90 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskSizeHintCache.h"
+#include <atomic>
+
+namespace
+{
+    class Counters
+    {
+      public:
+        std::atomic< quint64 > hits { 0 };
+        std::atomic< quint64 > misses { 0 };
+        std::atomic< quint64 > invalidations { 0 };
+    };
+}
+
+static Counters qskCounters;
+
+QskSizeHintCache::QskSizeHintCache()
+    : m_count( 0 )
+    , m_next( 0 )
+{
+}
+
+bool QskSizeHintCache::lookup(
+    Qt::SizeHint which, const QSizeF& constraint, QSizeF& hint ) const
+{
+    for ( int i = 0; i < m_count; i++ )
+    {
+        const auto& entry = m_entries[ i ];
+
+        if ( entry.which == which && entry.constraint == constraint )
+        {
+            hint = entry.hint;
+            qskCounters.hits++;
+
+            return true;
+        }
+    }
+
+    qskCounters.misses++;
+    return false;
+}
+
+void QskSizeHintCache::insert(
+    Qt::SizeHint which, const QSizeF& constraint, const QSizeF& hint )
+{
+    // replacing the oldest entry, when being full
+
+    auto& entry = m_entries[ m_next ];
+
+    entry.constraint = constraint;
+    entry.hint = hint;
+    entry.which = which;
+
+    m_next = ( m_next + 1 ) % Capacity;
+
+    if ( m_count < Capacity )
+        m_count++;
+}
+
+void QskSizeHintCache::invalidate()
+{
+    if ( m_count > 0 )
+    {
+        m_count = m_next = 0;
+        qskCounters.invalidations++;
+    }
+}
+
+QskSizeHintCache::Statistics QskSizeHintCache::statistics()
+{
+    Statistics statistics;
+
+    statistics.hits = qskCounters.hits;
+    statistics.misses = qskCounters.misses;
+    statistics.invalidations = qskCounters.invalidations;
+
+    return statistics;
+}
+
+void QskSizeHintCache::resetStatistics()
+{
+    qskCounters.hits = 0;
+    qskCounters.misses = 0;
+    qskCounters.invalidations = 0;
+}
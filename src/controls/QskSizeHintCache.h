@@ -0,0 +1,69 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_SIZE_HINT_CACHE_H
+#define QSK_SIZE_HINT_CACHE_H
+
+#include "QskGlobal.h"
+#include <qsize.h>
+
+/*
+    Layout engines often ask for the same constrained size hints
+    ( heightForWidth/widthForHeight ) several times during a layout pass.
+    QskControl remembers the most recent results, until the hints
+    get invalidated by resetImplicitSize(), a changed layout constraint
+    or a change of the skin states. This is done for controls without
+    child items only, as their hints might depend on the children.
+
+    The unconstrained preferred size is not stored here, as it
+    is cached as implicit size of the item.
+ */
+class QSK_EXPORT QskSizeHintCache
+{
+  public:
+    class Statistics
+    {
+      public:
+        inline qreal hitRate() const
+        {
+            const auto lookups = hits + misses;
+            return lookups ? qreal( hits ) / lookups : 0.0;
+        }
+
+        quint64 hits = 0;
+        quint64 misses = 0;
+
+        // how often non empty caches have been cleared
+        quint64 invalidations = 0;
+    };
+
+    QskSizeHintCache();
+
+    bool lookup( Qt::SizeHint, const QSizeF& constraint, QSizeF& hint ) const;
+    void insert( Qt::SizeHint, const QSizeF& constraint, const QSizeF& hint );
+
+    void invalidate();
+
+    // accumulated over all controls of the application
+    static Statistics statistics();
+    static void resetStatistics();
+
+  private:
+    enum { Capacity = 6 };
+
+    struct Entry
+    {
+        QSizeF constraint;
+        QSizeF hint;
+        int which;
+    };
+
+    Entry m_entries[ Capacity ];
+
+    quint8 m_count;
+    quint8 m_next;
+};
+
+#endif
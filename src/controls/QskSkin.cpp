@@ -92,6 +92,9 @@ QSK_QT_PRIVATE_END
 #include "QskStatusIndicator.h"
 #include "QskStatusIndicatorSkinlet.h"
 
+#include "QskVirtualKeyboard.h"
+#include "QskVirtualKeyboardSkinlet.h"
+
 static inline QskSkinlet* qskNewSkinlet( const QMetaObject* metaObject, QskSkin* skin )
 {
     const QByteArray signature = metaObject->className() + QByteArrayLiteral( "(QskSkin*)" );
@@ -146,6 +149,15 @@ QskSkin::QskSkin( QObject* parent )
     : QObject( parent )
     , m_data( new PrivateData() )
 {
+    /*
+        The skin table is shared by all controls and is usually not modified
+        after the skin has been set up. So it is worth to compile it into
+        a representation that can be resolved without hashing.
+        Any modification invalidates the compiled table and it will be
+        recompiled on the next lookup.
+     */
+    m_data->hintTable.setAutoCompile( true );
+
     declareSkinlet< QskControl, QskSkinlet >();
 
     declareSkinlet< QskBox, QskBoxSkinlet >();
@@ -170,6 +182,7 @@ QskSkin::QskSkin( QObject* parent )
     declareSkinlet< QskTextLabel, QskTextLabelSkinlet >();
     declareSkinlet< QskTextInput, QskTextInputSkinlet >();
     declareSkinlet< QskProgressBar, QskProgressBarSkinlet >();
+    declareSkinlet< QskVirtualKeyboard, QskVirtualKeyboardSkinlet >();
 
     const QFont font = QGuiApplication::font();
     setupFonts( font.family(), font.weight(), font.italic() );
@@ -347,6 +360,11 @@ QString QskSkin::dialogButtonText( int action ) const
     return text;
 }
 
+QByteArray QskSkin::snapshotKey() const
+{
+    return QByteArray();
+}
+
 const int* QskSkin::dialogButtonLayout( Qt::Orientation orientation ) const
 {
     // auto policy = QPlatformDialogHelper::UnknownLayout;
@@ -8,6 +8,7 @@
 
 #include "QskAspect.h"
 
+#include <qbytearray.h>
 #include <qcolor.h>
 #include <qobject.h>
 
@@ -77,6 +78,13 @@ class QSK_EXPORT QskSkin : public QObject
     virtual const int* dialogButtonLayout( Qt::Orientation ) const;
     virtual QString dialogButtonText( int button ) const;
 
+    /*
+        Identifies the setup code of the skin in a snapshot ( see QskSkinSnapshot ).
+        Skins supporting snapshots have to return a different key,
+        whenever the code, that initializes their hints, has been modified.
+     */
+    virtual QByteArray snapshotKey() const;
+
     QskSkinlet* skinlet( const QMetaObject* );
 
     const QskSkinHintTable& hintTable() const;
@@ -6,10 +6,24 @@
 #include "QskSkinHintTable.h"
 #include "QskAnimationHint.h"
 
+#include <algorithm>
+#include <atomic>
 #include <limits>
+#include <vector>
 
 const QVariant QskSkinHintTable::invalidHint;
 
+static inline quint64 qskNextGeneration()
+{
+    /*
+        The generation is unique for all tables, so that an
+        outdated generation never matches the one of another table.
+        Tables might also be modified in worker threads.
+     */
+    static std::atomic< quint64 > generation { 0 };
+    return ++generation;
+}
+
 inline const QVariant* qskResolvedHint( QskAspect aspect,
     const std::unordered_map< QskAspect, QVariant >& hints,
     QskAspect* resolvedAspect )
@@ -70,12 +84,192 @@ inline const QVariant* qskResolvedHint( QskAspect aspect,
     }
 }
 
+/*
+    The compiled table is a flat representation of the hints, that
+    avoids hashing when resolving an aspect:
+
+    - the subcontrol is mapped to a row
+    - ( animator, type, primitive ) is mapped to a cell of the row
+    - each cell refers to a range of entries sorted by section,
+      placement and states in descending order
+
+    Dropping the state bits one by one, like it is done in qskResolvedHint,
+    always results in the lower bits of the initial states. So an entry
+    matches, when masking the states with "all bits up to its highest bit"
+    gives its states. The first match in descending order is the one,
+    that would have been found by dropping the fewest bits.
+ */
+class QskSkinHintTable::CompiledTable
+{
+  public:
+    // QskAspect::Primitive is stored in 5 bits
+    static constexpr uint primitiveCount = 1 << 5;
+    static constexpr uint cellCount = 2 * QskAspect::typeCount * primitiveCount;
+
+    struct Entry
+    {
+        quint16 states;
+        quint16 stateMask;
+
+        quint8 section;
+        quint8 placement;
+
+        QskAspect aspect;
+        const QVariant* value;
+    };
+
+    static inline int cellIndex( QskAspect aspect )
+    {
+        if ( aspect.type() >= QskAspect::typeCount )
+            return -1;
+
+        uint index = aspect.isAnimator() ? QskAspect::typeCount : 0;
+        index = ( index + aspect.type() ) * primitiveCount + aspect.primitive();
+
+        return static_cast< int >( index );
+    }
+
+    static inline quint16 stateMask( quint16 states )
+    {
+        if ( states == 0 )
+            return 0;
+
+        uint bit = 1u << 15;
+        while ( ( states & bit ) == 0 )
+            bit >>= 1;
+
+        return static_cast< quint16 >( ( bit << 1 ) - 1 );
+    }
+
+    bool build( const std::unordered_map< QskAspect, QVariant >& hints )
+    {
+        uint maxSubcontrol = 0;
+
+        for ( const auto& hint : hints )
+        {
+            if ( cellIndex( hint.first ) < 0 )
+                return false;
+
+            maxSubcontrol = qMax( maxSubcontrol, uint( hint.first.subControl() ) );
+        }
+
+        rows.assign( maxSubcontrol + 1, 0 );
+
+        quint16 rowCount = 0;
+        for ( const auto& hint : hints )
+        {
+            auto& row = rows[ hint.first.subControl() ];
+            if ( row == 0 )
+                row = ++rowCount;
+        }
+
+        entries.clear();
+        entries.reserve( hints.size() );
+
+        for ( const auto& hint : hints )
+        {
+            const auto aspect = hint.first;
+            const auto states = static_cast< quint16 >( aspect.states() );
+
+            entries.push_back( { states, stateMask( states ),
+                static_cast< quint8 >( aspect.section() ),
+                static_cast< quint8 >( aspect.placement() ),
+                aspect, &hint.second } );
+        }
+
+        std::sort( entries.begin(), entries.end(),
+            [this]( const Entry& e1, const Entry& e2 )
+            {
+                const auto c1 = cellOf( e1.aspect );
+                const auto c2 = cellOf( e2.aspect );
+
+                if ( c1 != c2 )
+                    return c1 < c2;
+
+                if ( e1.section != e2.section )
+                    return e1.section < e2.section;
+
+                if ( e1.placement != e2.placement )
+                    return e1.placement < e2.placement;
+
+                return e1.states > e2.states;
+            } );
+
+        offsets.assign( rowCount * cellCount + 1, 0 );
+
+        for ( const auto& entry : entries )
+            offsets[ cellOf( entry.aspect ) + 1 ]++;
+
+        for ( size_t i = 1; i < offsets.size(); i++ )
+            offsets[ i ] += offsets[ i - 1 ];
+
+        return true;
+    }
+
+    inline const Entry* find( QskAspect aspect ) const
+    {
+        const auto subControl = aspect.subControl();
+        if ( subControl >= rows.size() || rows[ subControl ] == 0 )
+            return nullptr;
+
+        const auto cell = cellIndex( aspect );
+        if ( cell < 0 )
+            return nullptr;
+
+        const auto index = ( rows[ subControl ] - 1 ) * cellCount + cell;
+
+        const auto begin = entries.data() + offsets[ index ];
+        const auto end = entries.data() + offsets[ index + 1 ];
+
+        if ( begin == end )
+            return nullptr;
+
+        const auto states = static_cast< quint16 >( aspect.states() );
+
+        const quint8 sections[] = { quint8( aspect.section() ), QskAspect::Body };
+        const quint8 placements[] = { quint8( aspect.placement() ), QskAspect::NoPlacement };
+
+        const int sectionCount = ( sections[ 0 ] != QskAspect::Body ) ? 2 : 1;
+        const int placementCount = ( placements[ 0 ] != QskAspect::NoPlacement ) ? 2 : 1;
+
+        for ( int i = 0; i < sectionCount; i++ )
+        {
+            for ( int j = 0; j < placementCount; j++ )
+            {
+                for ( auto entry = begin; entry != end; ++entry )
+                {
+                    if ( entry->section == sections[ i ]
+                        && entry->placement == placements[ j ]
+                        && ( states & entry->stateMask ) == entry->states )
+                    {
+                        return entry;
+                    }
+                }
+            }
+        }
+
+        return nullptr;
+    }
+
+  private:
+    inline uint cellOf( QskAspect aspect ) const
+    {
+        return ( rows[ aspect.subControl() ] - 1 ) * cellCount + cellIndex( aspect );
+    }
+
+    std::vector< quint16 > rows;
+    std::vector< quint32 > offsets;
+    std::vector< Entry > entries;
+};
+
 QskSkinHintTable::QskSkinHintTable()
+    : m_generation( qskNextGeneration() )
 {
 }
 
 QskSkinHintTable::~QskSkinHintTable()
 {
+    delete m_compiled;
     delete m_hints;
 }
 
@@ -98,6 +292,7 @@ bool QskSkinHintTable::setHint( QskAspect aspect, const QVariant& skinHint )
     auto it = m_hints->find( aspect );
     if ( it == m_hints->end() )
     {
+        invalidate();
         m_hints->emplace( aspect, skinHint );
 
         if ( aspect.isAnimator() )
@@ -131,6 +326,8 @@ bool QskSkinHintTable::removeHint( QskAspect aspect )
 
     if ( erased )
     {
+        invalidate();
+
         if ( aspect.isAnimator() )
             m_animatorCount--;
 
@@ -154,6 +351,8 @@ QVariant QskSkinHintTable::takeHint( QskAspect aspect )
         if ( it != m_hints->end() )
         {
             const auto value = it->second;
+
+            invalidate();
             m_hints->erase( it );
 
             if ( aspect.isAnimator() )
@@ -176,6 +375,8 @@ QVariant QskSkinHintTable::takeHint( QskAspect aspect )
 
 void QskSkinHintTable::clear()
 {
+    invalidate();
+
     delete m_hints;
     m_hints = nullptr;
 
@@ -183,21 +384,60 @@ void QskSkinHintTable::clear()
     m_states = QskAspect::NoState;
 }
 
+void QskSkinHintTable::setAutoCompile( bool on )
+{
+    m_autoCompile = on;
+}
+
+void QskSkinHintTable::compile() const
+{
+    if ( m_compiled || m_hints == nullptr )
+        return;
+
+    auto compiled = new CompiledTable();
+    if ( compiled->build( *m_hints ) )
+        m_compiled = compiled;
+    else
+        delete compiled;
+}
+
+void QskSkinHintTable::invalidate()
+{
+    delete m_compiled;
+    m_compiled = nullptr;
+
+    m_generation = qskNextGeneration();
+}
+
 const QVariant* QskSkinHintTable::resolvedHint(
     QskAspect aspect, QskAspect* resolvedAspect ) const
 {
-    if ( m_hints != nullptr )
-        return qskResolvedHint( aspect & m_states, *m_hints, resolvedAspect );
+    if ( m_hints == nullptr )
+        return nullptr;
+
+    if ( m_autoCompile && m_compiled == nullptr )
+        compile();
+
+    if ( m_compiled )
+    {
+        if ( const auto entry = m_compiled->find( aspect & m_states ) )
+        {
+            if ( resolvedAspect )
+                *resolvedAspect = entry->aspect;
 
-    return nullptr;
+            return entry->value;
+        }
+
+        return nullptr;
+    }
+
+    return qskResolvedHint( aspect & m_states, *m_hints, resolvedAspect );
 }
 
 QskAspect QskSkinHintTable::resolvedAspect( QskAspect aspect ) const
 {
     QskAspect a;
-
-    if ( m_hints != nullptr )
-        qskResolvedHint( aspect & m_states, *m_hints, &a );
+    ( void ) resolvedHint( aspect, &a );
 
     return a;
 }
@@ -45,6 +45,9 @@ class QSK_EXPORT QskSkinHintTable
     const QVariant* resolvedHint( QskAspect,
         QskAspect* resolvedAspect = nullptr ) const;
 
+    template< typename T > const T* resolvedHintData(
+        QskAspect, QskAspect* resolvedAspect = nullptr ) const;
+
     QskAspect resolvedAspect( QskAspect ) const;
 
     QskAspect resolvedAnimator(
@@ -52,15 +55,32 @@ class QSK_EXPORT QskSkinHintTable
 
     bool isResolutionMatching( QskAspect, QskAspect ) const;
 
+    void setAutoCompile( bool );
+    bool autoCompile() const;
+
+    void compile() const;
+    bool isCompiled() const;
+
+    quint64 generation() const;
+
   private:
     Q_DISABLE_COPY( QskSkinHintTable )
 
+    void invalidate();
+
     static const QVariant invalidHint;
 
     typedef std::unordered_map< QskAspect, QVariant > HintMap;
     HintMap* m_hints = nullptr;
 
+    class CompiledTable;
+    mutable CompiledTable* m_compiled = nullptr;
+
+    quint64 m_generation;
+
     unsigned short m_animatorCount = 0;
+    bool m_autoCompile = false;
+
     QskAspect::States m_states;
 };
 
@@ -79,6 +99,21 @@ inline bool QskSkinHintTable::hasAnimators() const
     return m_animatorCount > 0;
 }
 
+inline bool QskSkinHintTable::autoCompile() const
+{
+    return m_autoCompile;
+}
+
+inline bool QskSkinHintTable::isCompiled() const
+{
+    return m_compiled != nullptr;
+}
+
+inline quint64 QskSkinHintTable::generation() const
+{
+    return m_generation;
+}
+
 inline bool QskSkinHintTable::hasHint( QskAspect aspect ) const
 {
     if ( m_hints != nullptr )
@@ -99,6 +134,20 @@ inline const QVariant& QskSkinHintTable::hint( QskAspect aspect ) const
     return invalidHint;
 }
 
+template< typename T >
+inline const T* qskHintData( const QVariant& hint )
+{
+    /*
+        The hints are stored with the type they have been set, so the hot
+        types ( metrics, colors, gradients, box hints ) can be accessed
+        in place without any conversion or copying of the variant.
+     */
+    if ( hint.userType() == qMetaTypeId< T >() )
+        return static_cast< const T* >( hint.constData() );
+
+    return nullptr;
+}
+
 template< typename T >
 inline bool QskSkinHintTable::setHint( QskAspect aspect, const T& hint )
 {
@@ -108,7 +157,22 @@ inline bool QskSkinHintTable::setHint( QskAspect aspect, const T& hint )
 template< typename T >
 inline T QskSkinHintTable::hint( QskAspect aspect ) const
 {
-    return hint( aspect ).value< T >();
+    const auto& v = hint( aspect );
+
+    if ( const auto value = qskHintData< T >( v ) )
+        return *value;
+
+    return v.value< T >();
+}
+
+template< typename T >
+inline const T* QskSkinHintTable::resolvedHintData(
+    QskAspect aspect, QskAspect* resolvedAspect ) const
+{
+    if ( const auto v = resolvedHint( aspect, resolvedAspect ) )
+        return qskHintData< T >( *v );
+
+    return nullptr;
 }
 
 #endif
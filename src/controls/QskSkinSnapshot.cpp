@@ -0,0 +1,834 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskSkinSnapshot.h"
+#include "QskAnimationHint.h"
+#include "QskArcMetrics.h"
+#include "QskBoxBorderColors.h"
+#include "QskBoxBorderMetrics.h"
+#include "QskBoxShapeMetrics.h"
+#include "QskColorFilter.h"
+#include "QskGradient.h"
+#include "QskGraphic.h"
+#include "QskGraphicIO.h"
+#include "QskMargins.h"
+#include "QskShadowMetrics.h"
+#include "QskSkin.h"
+#include "QskSkinHintTable.h"
+#include "QskTextOptions.h"
+
+#include <qdatastream.h>
+#include <qdir.h>
+#include <qfile.h>
+#include <qfont.h>
+#include <qglobalstatic.h>
+#include <qguiapplication.h>
+#include <qhash.h>
+#include <qmutex.h>
+#include <qscreen.h>
+
+#include <cstring>
+#include <vector>
+
+static const char qskMagicNumber[] = "QSKS";
+static const quint16 qskSnapshotVersion = 2;
+
+/*
+    Snapshots are not meant to be exchanged between different
+    builds, so we can use the stream format of the Qt version
+    we have been built with.
+ */
+static const int qskDataStreamVersion = QDataStream::Qt_DefaultCompiledVersion;
+
+namespace
+{
+    enum ValueType : quint8
+    {
+        Builtin,
+        Enumeration,
+
+        Margins,
+        Gradient,
+        BoxShape,
+        BoxBorderMetrics,
+        BoxBorderColors,
+        ShadowMetrics,
+        ArcMetrics,
+        TextOptions,
+        AnimationHint,
+        ColorFilter,
+        Graphic
+    };
+
+    class Settings
+    {
+      public:
+        Settings()
+            : directory( qEnvironmentVariable( "QSK_SKIN_SNAPSHOTS" ) )
+        {
+        }
+
+        QMutex mutex;
+        QString directory;
+    };
+}
+
+Q_GLOBAL_STATIC( Settings, qskSettings )
+
+/*
+    Skins convert their metrics from the resolution of the screen,
+    so a snapshot is only valid for the same screen setup.
+ */
+static QVector< double > qskScreenFactors()
+{
+    QVector< double > factors( 3, 0.0 );
+
+    if ( const auto screen = QGuiApplication::primaryScreen() )
+    {
+        factors[ 0 ] = screen->logicalDotsPerInchX();
+        factors[ 1 ] = screen->physicalDotsPerInch();
+        factors[ 2 ] = screen->devicePixelRatio();
+    }
+
+    return factors;
+}
+
+static inline void qskInitStream( QDataStream& stream )
+{
+    stream.setVersion( qskDataStreamVersion );
+    stream.setByteOrder( QDataStream::LittleEndian );
+}
+
+static inline int qskTypeId( const QByteArray& typeName )
+{
+#if QT_VERSION >= QT_VERSION_CHECK( 6, 0, 0 )
+    return QMetaType::fromName( typeName ).id();
+#else
+    return QMetaType::type( typeName.constData() );
+#endif
+}
+
+static inline QVariant qskVariant( int typeId, const void* data )
+{
+#if QT_VERSION >= QT_VERSION_CHECK( 6, 0, 0 )
+    return QVariant( QMetaType( typeId ), data );
+#else
+    return QVariant( typeId, data );
+#endif
+}
+
+static inline int qskTypeSize( int typeId )
+{
+#if QT_VERSION >= QT_VERSION_CHECK( 6, 0, 0 )
+    return QMetaType( typeId ).sizeOf();
+#else
+    return QMetaType::sizeOf( typeId );
+#endif
+}
+
+static inline bool qskIsEnumeration( int typeId )
+{
+#if QT_VERSION >= QT_VERSION_CHECK( 6, 0, 0 )
+    return QMetaType( typeId ).flags().testFlag( QMetaType::IsEnumeration );
+#else
+    return QMetaType::typeFlags( typeId ).testFlag( QMetaType::IsEnumeration );
+#endif
+}
+
+static void qskWriteAspect( QDataStream& s, QskAspect aspect )
+{
+    s << static_cast< quint16 >( aspect.subControl() );
+    s << static_cast< quint8 >( aspect.section() );
+    s << static_cast< quint8 >( aspect.type() );
+    s << static_cast< quint8 >( aspect.primitive() );
+    s << static_cast< quint8 >( aspect.placement() );
+    s << static_cast< quint8 >( aspect.isAnimator() );
+    s << static_cast< quint16 >( int( aspect.states() ) );
+}
+
+static bool qskReadAspect( QDataStream& s,
+    const QVector< QskAspect::Subcontrol >& subControls, QskAspect& aspect )
+{
+    quint16 subControl, states;
+    quint8 section, type, primitive, placement, isAnimator;
+
+    s >> subControl >> section >> type >> primitive
+        >> placement >> isAnimator >> states;
+
+    if ( subControl >= subControls.size() )
+        return false;
+
+    aspect = QskAspect();
+
+    aspect.setSubcontrol( subControls[ subControl ] );
+    aspect.setSection( static_cast< QskAspect::Section >( section ) );
+    aspect.setPrimitive( static_cast< QskAspect::Type >( type ),
+        static_cast< QskAspect::Primitive >( primitive ) );
+    aspect.setPlacement( static_cast< QskAspect::Placement >( placement ) );
+    aspect.setAnimator( isAnimator != 0 );
+    aspect.setStates( QskAspect::States( QFlag( states ) ) );
+
+    return true;
+}
+
+static void qskWriteMargins( QDataStream& s, const QskMargins& margins )
+{
+    s << margins.left() << margins.top() << margins.right() << margins.bottom();
+}
+
+static QskMargins qskReadMargins( QDataStream& s )
+{
+    qreal left, top, right, bottom;
+    s >> left >> top >> right >> bottom;
+
+    return QskMargins( left, top, right, bottom );
+}
+
+static void qskWriteGradient( QDataStream& s, const QskGradient& gradient )
+{
+    s << static_cast< quint8 >( gradient.type() );
+    s << static_cast< quint8 >( gradient.spreadMode() );
+    s << static_cast< quint8 >( gradient.stretchMode() );
+
+    switch ( gradient.type() )
+    {
+        case QskGradient::Linear:
+        {
+            const auto dir = gradient.linearDirection();
+            s << dir.x1() << dir.y1() << dir.x2() << dir.y2();
+            break;
+        }
+        case QskGradient::Radial:
+        {
+            const auto dir = gradient.radialDirection();
+            s << dir.x() << dir.y() << dir.radiusX() << dir.radiusY();
+            break;
+        }
+        case QskGradient::Conic:
+        {
+            const auto dir = gradient.conicDirection();
+            s << dir.x() << dir.y() << dir.startAngle() << dir.spanAngle();
+            break;
+        }
+        default:
+            break;
+    }
+
+    const auto& stops = gradient.stops();
+
+    s << static_cast< quint32 >( stops.size() );
+    for ( const auto& stop : stops )
+        s << stop.position() << stop.color();
+}
+
+static QskGradient qskReadGradient( QDataStream& s )
+{
+    quint8 type, spreadMode, stretchMode;
+    s >> type >> spreadMode >> stretchMode;
+
+    qreal v[ 4 ] = { 0.0, 0.0, 0.0, 0.0 };
+    if ( type != QskGradient::Stops )
+        s >> v[ 0 ] >> v[ 1 ] >> v[ 2 ] >> v[ 3 ];
+
+    quint32 count;
+    s >> count;
+
+    QskGradientStops stops;
+    stops.reserve( qMin( count, 256u ) );
+
+    for ( quint32 i = 0; i < count && s.status() == QDataStream::Ok; i++ )
+    {
+        qreal position;
+        QColor color;
+
+        s >> position >> color;
+        stops += QskGradientStop( position, color );
+    }
+
+    QskGradient gradient( stops );
+
+    switch ( type )
+    {
+        case QskGradient::Linear:
+            gradient.setLinearDirection( v[ 0 ], v[ 1 ], v[ 2 ], v[ 3 ] );
+            break;
+
+        case QskGradient::Radial:
+            gradient.setRadialDirection( v[ 0 ], v[ 1 ], v[ 2 ], v[ 3 ] );
+            break;
+
+        case QskGradient::Conic:
+            gradient.setConicDirection( v[ 0 ], v[ 1 ], v[ 2 ], v[ 3 ] );
+            break;
+
+        default:
+            break;
+    }
+
+    gradient.setSpreadMode( static_cast< QskGradient::SpreadMode >( spreadMode ) );
+    gradient.setStretchMode( static_cast< QskGradient::StretchMode >( stretchMode ) );
+
+    return gradient;
+}
+
+static void qskWriteColorFilter( QDataStream& s, const QskColorFilter& filter )
+{
+    const auto& substitutions = filter.substitutions();
+
+    s << static_cast< quint32 >( substitutions.size() );
+    for ( const auto& substitution : substitutions )
+        s << substitution.first << substitution.second;
+}
+
+static QskColorFilter qskReadColorFilter( QDataStream& s )
+{
+    QskColorFilter filter;
+
+    quint32 count;
+    s >> count;
+
+    for ( quint32 i = 0; i < count && s.status() == QDataStream::Ok; i++ )
+    {
+        QRgb from, to;
+        s >> from >> to;
+
+        filter.addColorSubstitution( from, to );
+    }
+
+    return filter;
+}
+
+static bool qskWriteValue( QDataStream& s, const QVariant& value )
+{
+    const int typeId = value.userType();
+
+    if ( typeId < QMetaType::User )
+    {
+        s << static_cast< quint8 >( Builtin ) << value;
+    }
+    else if ( qskIsEnumeration( typeId ) )
+    {
+        qint64 v = 0;
+
+        const int size = qskTypeSize( typeId );
+        if ( size <= 0 || size > int( sizeof( v ) ) )
+            return false;
+
+        std::memcpy( &v, value.constData(), size );
+
+        s << static_cast< quint8 >( Enumeration );
+        s << QByteArray( value.typeName() ) << v;
+    }
+    else if ( typeId == qMetaTypeId< QskMargins >() )
+    {
+        s << static_cast< quint8 >( Margins );
+        qskWriteMargins( s, value.value< QskMargins >() );
+    }
+    else if ( typeId == qMetaTypeId< QskGradient >() )
+    {
+        s << static_cast< quint8 >( Gradient );
+        qskWriteGradient( s, value.value< QskGradient >() );
+    }
+    else if ( typeId == qMetaTypeId< QskBoxShapeMetrics >() )
+    {
+        const auto shape = value.value< QskBoxShapeMetrics >();
+
+        s << static_cast< quint8 >( BoxShape );
+        s << shape.topLeft() << shape.topRight()
+            << shape.bottomLeft() << shape.bottomRight();
+        s << static_cast< quint8 >( shape.sizeMode() );
+        s << static_cast< quint8 >( shape.aspectRatioMode() );
+    }
+    else if ( typeId == qMetaTypeId< QskBoxBorderMetrics >() )
+    {
+        const auto metrics = value.value< QskBoxBorderMetrics >();
+
+        s << static_cast< quint8 >( BoxBorderMetrics );
+        qskWriteMargins( s, metrics.widths() );
+        s << static_cast< quint8 >( metrics.sizeMode() );
+    }
+    else if ( typeId == qMetaTypeId< QskBoxBorderColors >() )
+    {
+        const auto colors = value.value< QskBoxBorderColors >();
+
+        s << static_cast< quint8 >( BoxBorderColors );
+        qskWriteGradient( s, colors.left() );
+        qskWriteGradient( s, colors.top() );
+        qskWriteGradient( s, colors.right() );
+        qskWriteGradient( s, colors.bottom() );
+    }
+    else if ( typeId == qMetaTypeId< QskShadowMetrics >() )
+    {
+        const auto metrics = value.value< QskShadowMetrics >();
+
+        s << static_cast< quint8 >( ShadowMetrics );
+        s << metrics.spreadRadius() << metrics.blurRadius() << metrics.offset();
+        s << static_cast< quint8 >( metrics.sizeMode() );
+    }
+    else if ( typeId == qMetaTypeId< QskArcMetrics >() )
+    {
+        const auto metrics = value.value< QskArcMetrics >();
+
+        s << static_cast< quint8 >( ArcMetrics );
+        s << metrics.width() << metrics.startAngle() << metrics.spanAngle();
+        s << static_cast< quint8 >( metrics.sizeMode() );
+    }
+    else if ( typeId == qMetaTypeId< QskTextOptions >() )
+    {
+        const auto options = value.value< QskTextOptions >();
+
+        s << static_cast< quint8 >( TextOptions );
+        s << static_cast< quint8 >( options.format() );
+        s << static_cast< quint8 >( options.elideMode() );
+        s << static_cast< quint8 >( options.fontSizeMode() );
+        s << static_cast< quint8 >( options.wrapMode() );
+        s << static_cast< qint32 >( options.maximumLineCount() );
+    }
+    else if ( typeId == qMetaTypeId< QskAnimationHint >() )
+    {
+        const auto hint = value.value< QskAnimationHint >();
+
+        s << static_cast< quint8 >( AnimationHint );
+        s << static_cast< quint32 >( hint.duration );
+        s << static_cast< quint8 >( hint.type );
+        s << static_cast< quint8 >( int( hint.updateFlags ) );
+    }
+    else if ( typeId == qMetaTypeId< QskColorFilter >() )
+    {
+        s << static_cast< quint8 >( ColorFilter );
+        qskWriteColorFilter( s, value.value< QskColorFilter >() );
+    }
+    else if ( typeId == qMetaTypeId< QskGraphic >() )
+    {
+        QByteArray data;
+        if ( !QskGraphicIO::write( value.value< QskGraphic >(), data ) )
+            return false;
+
+        s << static_cast< quint8 >( Graphic ) << data;
+    }
+    else
+    {
+        qWarning( "QskSkinSnapshot: hints of type %s are not supported",
+            value.typeName() );
+
+        return false;
+    }
+
+    return true;
+}
+
+static bool qskReadValue( QDataStream& s, QVariant& value )
+{
+    quint8 valueType;
+    s >> valueType;
+
+    switch ( valueType )
+    {
+        case Builtin:
+        {
+            s >> value;
+            break;
+        }
+        case Enumeration:
+        {
+            QByteArray typeName;
+            qint64 v;
+
+            s >> typeName >> v;
+
+            const int typeId = qskTypeId( typeName );
+            if ( typeId == QMetaType::UnknownType )
+                return false;
+
+            const int size = qskTypeSize( typeId );
+            if ( size <= 0 || size > int( sizeof( v ) ) )
+                return false;
+
+            value = qskVariant( typeId, &v );
+            break;
+        }
+        case Margins:
+        {
+            value = QVariant::fromValue( qskReadMargins( s ) );
+            break;
+        }
+        case Gradient:
+        {
+            value = QVariant::fromValue( qskReadGradient( s ) );
+            break;
+        }
+        case BoxShape:
+        {
+            QSizeF topLeft, topRight, bottomLeft, bottomRight;
+            quint8 sizeMode, aspectRatioMode;
+
+            s >> topLeft >> topRight >> bottomLeft >> bottomRight;
+            s >> sizeMode >> aspectRatioMode;
+
+            QskBoxShapeMetrics shape;
+            shape.setRadius( topLeft, topRight, bottomLeft, bottomRight );
+            shape.setSizeMode( static_cast< Qt::SizeMode >( sizeMode ) );
+            shape.setAspectRatioMode(
+                static_cast< Qt::AspectRatioMode >( aspectRatioMode ) );
+
+            value = QVariant::fromValue( shape );
+            break;
+        }
+        case BoxBorderMetrics:
+        {
+            const auto widths = qskReadMargins( s );
+
+            quint8 sizeMode;
+            s >> sizeMode;
+
+            value = QVariant::fromValue( QskBoxBorderMetrics(
+                widths, static_cast< Qt::SizeMode >( sizeMode ) ) );
+            break;
+        }
+        case BoxBorderColors:
+        {
+            const auto left = qskReadGradient( s );
+            const auto top = qskReadGradient( s );
+            const auto right = qskReadGradient( s );
+            const auto bottom = qskReadGradient( s );
+
+            value = QVariant::fromValue(
+                QskBoxBorderColors( left, top, right, bottom ) );
+            break;
+        }
+        case ShadowMetrics:
+        {
+            qreal spreadRadius, blurRadius;
+            QPointF offset;
+            quint8 sizeMode;
+
+            s >> spreadRadius >> blurRadius >> offset >> sizeMode;
+
+            value = QVariant::fromValue( QskShadowMetrics( spreadRadius,
+                blurRadius, offset, static_cast< Qt::SizeMode >( sizeMode ) ) );
+            break;
+        }
+        case ArcMetrics:
+        {
+            qreal width, startAngle, spanAngle;
+            quint8 sizeMode;
+
+            s >> width >> startAngle >> spanAngle >> sizeMode;
+
+            value = QVariant::fromValue( QskArcMetrics( width,
+                startAngle, spanAngle, static_cast< Qt::SizeMode >( sizeMode ) ) );
+            break;
+        }
+        case TextOptions:
+        {
+            quint8 format, elideMode, fontSizeMode, wrapMode;
+            qint32 maximumLineCount;
+
+            s >> format >> elideMode >> fontSizeMode >> wrapMode >> maximumLineCount;
+
+            QskTextOptions options;
+            options.setFormat( static_cast< QskTextOptions::TextFormat >( format ) );
+            options.setElideMode( static_cast< Qt::TextElideMode >( elideMode ) );
+            options.setFontSizeMode(
+                static_cast< QskTextOptions::FontSizeMode >( fontSizeMode ) );
+            options.setWrapMode( static_cast< QskTextOptions::WrapMode >( wrapMode ) );
+            options.setMaximumLineCount( maximumLineCount );
+
+            value = QVariant::fromValue( options );
+            break;
+        }
+        case AnimationHint:
+        {
+            quint32 duration;
+            quint8 type, updateFlags;
+
+            s >> duration >> type >> updateFlags;
+
+            QskAnimationHint hint( duration, static_cast< QEasingCurve::Type >( type ) );
+            hint.updateFlags = QskAnimationHint::UpdateFlags( QFlag( updateFlags ) );
+
+            value = QVariant::fromValue( hint );
+            break;
+        }
+        case ColorFilter:
+        {
+            value = QVariant::fromValue( qskReadColorFilter( s ) );
+            break;
+        }
+        case Graphic:
+        {
+            QByteArray data;
+            s >> data;
+
+            value = QVariant::fromValue( QskGraphicIO::read( data ) );
+            break;
+        }
+        default:
+            return false;
+    }
+
+    return s.status() == QDataStream::Ok;
+}
+
+bool QskSkinSnapshot::write( const QskSkin* skin, const QString& fileName )
+{
+    QFile file( fileName );
+    if ( file.open( QIODevice::WriteOnly | QIODevice::Truncate ) == false )
+    {
+        qWarning( "QskSkinSnapshot::write can't open %s", qPrintable( fileName ) );
+        return false;
+    }
+
+    if ( !write( skin, &file ) )
+    {
+        file.remove();
+        return false;
+    }
+
+    return true;
+}
+
+bool QskSkinSnapshot::write( const QskSkin* skin, QIODevice* dev )
+{
+    if ( skin == nullptr || dev == nullptr )
+        return false;
+
+    QDataStream s( dev );
+    qskInitStream( s );
+
+    s.writeRawData( qskMagicNumber, 4 );
+    s << qskSnapshotVersion;
+    s << QByteArray( QSK_VERSION_STR );
+    s << static_cast< quint32 >( QT_VERSION );
+    s << QByteArray( skin->metaObject()->className() );
+    s << skin->snapshotKey();
+    s << qskScreenFactors();
+
+    // subcontrols are enumerated at runtime, so we store their names
+    s << QskAspect::subControlNames();
+
+    const auto& hints = skin->hintTable().hints();
+
+    s << static_cast< quint32 >( hints.size() );
+    for ( const auto& hint : hints )
+    {
+        qskWriteAspect( s, hint.first );
+
+        if ( !qskWriteValue( s, hint.second ) )
+            return false;
+    }
+
+    const auto& fonts = skin->fonts();
+
+    s << static_cast< quint32 >( fonts.size() );
+    for ( const auto& font : fonts )
+        s << static_cast< qint32 >( font.first ) << font.second;
+
+    const auto& filters = skin->graphicFilters();
+
+    s << static_cast< quint32 >( filters.size() );
+    for ( const auto& filter : filters )
+    {
+        s << static_cast< qint32 >( filter.first );
+        qskWriteColorFilter( s, filter.second );
+    }
+
+    return s.status() == QDataStream::Ok;
+}
+
+bool QskSkinSnapshot::read( QskSkin* skin, const QString& fileName )
+{
+    QFile file( fileName );
+    if ( file.open( QIODevice::ReadOnly ) == false )
+        return false;
+
+    return read( skin, &file );
+}
+
+bool QskSkinSnapshot::read( QskSkin* skin, QIODevice* dev )
+{
+    if ( skin == nullptr || dev == nullptr )
+        return false;
+
+    QDataStream s( dev );
+    qskInitStream( s );
+
+    char magicNumber[ 4 ];
+    if ( s.readRawData( magicNumber, 4 ) != 4
+        || std::memcmp( magicNumber, qskMagicNumber, 4 ) != 0 )
+    {
+        qWarning( "QskSkinSnapshot::read: bad magic number" );
+        return false;
+    }
+
+    quint16 version;
+    QByteArray qskVersion, className, key;
+    quint32 qtVersion;
+    QVector< double > screenFactors;
+
+    s >> version;
+    if ( version != qskSnapshotVersion )
+    {
+        qWarning( "QskSkinSnapshot::read: incompatible snapshot" );
+        return false;
+    }
+
+    s >> qskVersion >> qtVersion >> className >> key >> screenFactors;
+
+    if ( s.status() != QDataStream::Ok
+        || qskVersion != QSK_VERSION_STR || qtVersion != QT_VERSION
+        || className != skin->metaObject()->className()
+        || key != skin->snapshotKey() || screenFactors != qskScreenFactors() )
+    {
+        qWarning( "QskSkinSnapshot::read: incompatible snapshot" );
+        return false;
+    }
+
+    QVector< QskAspect::Subcontrol > subControls;
+
+    {
+        QVector< QByteArray > names;
+        s >> names;
+
+        const auto currentNames = QskAspect::subControlNames();
+
+        QHash< QByteArray, int > idTable;
+        idTable.reserve( currentNames.size() );
+
+        for ( int i = 0; i < currentNames.size(); i++ )
+            idTable.insert( currentNames[ i ], i + 1 );
+
+        subControls.reserve( names.size() + 1 );
+        subControls += QskAspect::Control;
+
+        for ( const auto& name : qAsConst( names ) )
+        {
+            const int id = idTable.value( name, -1 );
+            if ( id < 0 )
+            {
+                // written by a different build
+                qWarning( "QskSkinSnapshot::read: unknown subcontrol %s",
+                    name.constData() );
+
+                return false;
+            }
+
+            subControls += static_cast< QskAspect::Subcontrol >( id );
+        }
+    }
+
+    // reading everything before modifying the skin
+
+    std::vector< std::pair< QskAspect, QVariant > > hints;
+
+    quint32 count;
+    s >> count;
+
+    hints.reserve( qMin( count, 100000u ) );
+
+    for ( quint32 i = 0; i < count; i++ )
+    {
+        QskAspect aspect;
+        QVariant value;
+
+        if ( !qskReadAspect( s, subControls, aspect ) || !qskReadValue( s, value ) )
+        {
+            qWarning( "QskSkinSnapshot::read: corrupted data" );
+            return false;
+        }
+
+        hints.emplace_back( aspect, value );
+    }
+
+    std::vector< std::pair< int, QFont > > fonts;
+
+    s >> count;
+    for ( quint32 i = 0; i < count && s.status() == QDataStream::Ok; i++ )
+    {
+        qint32 role;
+        QFont font;
+
+        s >> role >> font;
+        fonts.emplace_back( role, font );
+    }
+
+    std::vector< std::pair< int, QskColorFilter > > filters;
+
+    s >> count;
+    for ( quint32 i = 0; i < count && s.status() == QDataStream::Ok; i++ )
+    {
+        qint32 role;
+        s >> role;
+
+        filters.emplace_back( role, qskReadColorFilter( s ) );
+    }
+
+    if ( s.status() != QDataStream::Ok )
+    {
+        qWarning( "QskSkinSnapshot::read: corrupted data" );
+        return false;
+    }
+
+    auto& table = skin->hintTable();
+
+    table.clear();
+    for ( const auto& hint : hints )
+        table.setHint( hint.first, hint.second );
+
+    {
+        QVector< int > roles;
+        for ( const auto& font : skin->fonts() )
+            roles += font.first;
+
+        for ( const auto role : qAsConst( roles ) )
+            skin->resetFont( role );
+
+        for ( const auto& font : fonts )
+            skin->setFont( font.first, font.second );
+    }
+
+    {
+        QVector< int > roles;
+        for ( const auto& filter : skin->graphicFilters() )
+            roles += filter.first;
+
+        for ( const auto role : qAsConst( roles ) )
+            skin->resetGraphicFilter( role );
+
+        for ( const auto& filter : filters )
+            skin->setGraphicFilter( filter.first, filter.second );
+    }
+
+    return true;
+}
+
+void QskSkinSnapshot::setDirectory( const QString& directory )
+{
+    auto settings = qskSettings();
+
+    QMutexLocker locker( &settings->mutex );
+    settings->directory = directory;
+}
+
+QString QskSkinSnapshot::directory()
+{
+    auto settings = qskSettings();
+
+    QMutexLocker locker( &settings->mutex );
+    return settings->directory;
+}
+
+QString QskSkinSnapshot::fileName( const QString& skinName )
+{
+    const auto dir = directory();
+    if ( dir.isEmpty() || skinName.isEmpty() )
+        return QString();
+
+    QString name = skinName.toLower();
+    name.replace( QLatin1Char( ' ' ), QLatin1Char( '-' ) );
+    name.replace( QLatin1Char( '/' ), QLatin1Char( '-' ) );
+
+    return QDir( dir ).filePath( name + QStringLiteral( ".qsks" ) );
+}
@@ -0,0 +1,54 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_SKIN_SNAPSHOT_H
+#define QSK_SKIN_SNAPSHOT_H
+
+#include "QskGlobal.h"
+
+class QskSkin;
+class QString;
+class QIODevice;
+
+/*
+    A snapshot is a binary dump of the hint table, the fonts and the
+    graphic filters of a fully built skin. Restoring a skin from a snapshot
+    avoids running the setup code of the skin, what usually means
+    thousands of setHint calls.
+
+    Everything else ( skinlets, graphic providers, symbols ) is part
+    of the code of the skin and has to be done by its constructor.
+
+    A snapshot is only valid for the same build of QSkinny/Qt, the same
+    skin key ( QskSkin::snapshotKey() ) and the same resolution of
+    the primary screen. Snapshots not matching are rejected and the skin
+    falls back to its setup code.
+
+    The skin factories only read snapshots. Writing them is an explicit
+    step - f.e. with the skinsnapshot tool - that has to be done on
+    the target, whenever the code of a skin has been modified.
+ */
+namespace QskSkinSnapshot
+{
+    QSK_EXPORT bool write( const QskSkin*, const QString& fileName );
+    QSK_EXPORT bool write( const QskSkin*, QIODevice* );
+
+    // replaces hints, fonts and graphic filters of the skin
+    QSK_EXPORT bool read( QskSkin*, const QString& fileName );
+    QSK_EXPORT bool read( QskSkin*, QIODevice* );
+
+    /*
+        The directory, where skin factories look for snapshots.
+        It is initialized from the environment variable QSK_SKIN_SNAPSHOTS.
+        Snapshots are disabled, when no directory has been set.
+     */
+    QSK_EXPORT void setDirectory( const QString& );
+    QSK_EXPORT QString directory();
+
+    // path for the snapshot of a skin, empty when snapshots are disabled
+    QSK_EXPORT QString fileName( const QString& skinName );
+}
+
+#endif
@@ -14,7 +14,9 @@
 
 #include <qglobalstatic.h>
 #include <qguiapplication.h>
+#include <qhash.h>
 #include <qobject.h>
+#include <qpointer.h>
 #include <qvector.h>
 
 #include <unordered_map>
@@ -98,60 +100,63 @@ namespace
     class HintAnimator : public QskHintAnimator
     {
       public:
-        inline HintAnimator( const QskControl* control, const QskAspect aspect,
-            const QVariant& value1, const QVariant& value2, QskAnimationHint hint )
+        inline HintAnimator( const QskAspect aspect,
+            const QVariant& value1, const QVariant& value2 )
         {
             setAspect( aspect );
             setStartValue( value1 );
             setEndValue( value2 );
+        }
 
-            setDuration( hint.duration );
-            setEasingCurve( hint.type );
-            setUpdateFlags( hint.updateFlags );
-
-            setWindow( control->window() );
+        /*
+            The animator is never registered at the animator driver.
+            It is advanced by the clock of the transition - once
+            for all windows.
+         */
+        inline void prepare( qreal progress )
+        {
+            setup();
+            advance( progress );
         }
     };
 
-    class WindowAnimator
+    class ApplicationAnimator;
+
+    class Clock final : public QskAnimator
     {
       public:
-        WindowAnimator( QQuickWindow* = nullptr );
-
-        const QQuickWindow* window() const;
-
-        void start();
-        bool isRunning() const;
+        Clock( ApplicationAnimator* );
 
-        QVariant animatedHint( QskAspect ) const;
-        QVariant animatedGraphicFilter( int graphicRole ) const;
+        void start( QQuickWindow*, const QskAnimationHint& );
+        void moveToWindow( QQuickWindow* );
 
-        void addGraphicFilterAnimators( const QskAnimationHint&,
-            const QskSkin*, const QskSkin* );
-
-        void addItemAspects( QQuickItem*,
-            const QskAnimationHint&, const QSet< QskAspect >&,
-            const QskSkin*, const QskSkin* );
-
-        void update();
+      protected:
+        void advance( qreal ) override;
 
       private:
+        ApplicationAnimator* m_animator;
 
-        bool isControlAffected( const QskControl*,
-            const QVector< QskAspect::Subcontrol >&, QskAspect ) const;
+        /*
+            The clock runs linear and applies the easing curve itself,
+            so that it can continue in another window without a jump,
+            when the window it is attached to is closed.
+         */
+        QEasingCurve m_curve;
+        qreal m_offset = 0.0;
+    };
 
-        void addHints( const QskControl*,
-            const QskAnimationHint&, const QSet< QskAspect >& candidates,
-            const QskSkin* skin1, const QskSkin* skin2 );
+    class WindowAnimator
+    {
+      public:
+        WindowAnimator( QQuickWindow* );
 
-        void storeAnimator( const QskControl*, const QskAspect,
-            const QVariant&, const QVariant&, QskAnimationHint );
+        QQuickWindow* window() const;
 
-        void storeUpdateInfo( const QskControl*, QskAspect );
+        void storeUpdateInfo( const QskControl*, int updateModes );
+        void update();
 
+      private:
         QQuickWindow* m_window;
-        std::unordered_map< QskAspect, HintAnimator > m_animatorMap;
-        std::unordered_map< int, QskVariantAnimator > m_graphicFilterAnimatorMap;
         std::vector< UpdateInfo > m_updateInfos; // vector: for fast iteration
     };
 
@@ -160,101 +165,253 @@ namespace
         Q_OBJECT
 
       public:
-        ~ApplicationAnimator();
+        ApplicationAnimator();
+        ~ApplicationAnimator() override;
 
-        WindowAnimator* windowAnimator( const QQuickWindow* );
+        void setup( const QskSkin*, const QskAnimationHint& );
 
-        void add( WindowAnimator* );
+        void addGraphicFilterAnimators( const QskSkin*, const QskSkin* );
+        void addWindow( QQuickWindow*, const QSet< QskAspect >&,
+            const QskSkin*, const QskSkin* );
 
         void start();
         void reset();
         bool isRunning() const;
 
+        void advance( qreal progress );
+
+        QVariant animatedHint( const QQuickWindow*, QskAspect ) const;
+        QVariant animatedGraphicFilter( const QQuickWindow*, int graphicRole ) const;
+
       private Q_SLOTS:
-        // using functor slots ?
-        void notify( QQuickWindow* );
         void cleanup( QQuickWindow* );
 
       private:
         /*
-            It should be possible to find an implementation, that interpolates
-            a skin hint only once for all windows. But as our animtors are driven by
-            QQuickWindow::afterAnimating the code will have to be somehow tricky.
-            But as skin transitions are no operations, that happen often, we can accept
-            the overhaed of the current implementation and do the finetuning later.
+            The hints are interpolated once for all windows - only the
+            updates of the controls are scheduled per window. All hint
+            animators are driven by the same clock, that is attached
+            to one of the windows.
          */
+
+        WindowAnimator* windowAnimator( const QQuickWindow* ) const;
+        WindowAnimator* insertWindowAnimator( QQuickWindow* );
+        void removeWindow( QQuickWindow* );
+
+        void addPendingWindows();
+        bool isAnimatedWindow( const QQuickWindow* ) const;
+
+        void addItemAspects( WindowAnimator*, QQuickItem*,
+            const QSet< QskAspect >&, const QskSkin*, const QskSkin* );
+
+        void addHints( WindowAnimator*, const QskControl*,
+            const QSet< QskAspect >& candidates,
+            const QskSkin* skin1, const QskSkin* skin2 );
+
+        void addItemUpdates( WindowAnimator*, QQuickItem* );
+
+        bool isControlAffected( const QskControl*,
+            const QVector< QskAspect::Subcontrol >&, QskAspect ) const;
+
+        void storeAnimator( const QskAspect, const QVariant&, const QVariant& );
+        void storeUpdateInfo( WindowAnimator*, const QskControl*, QskAspect );
+
+        const QskSkin* m_skin = nullptr;
+        QskAnimationHint m_animationHint;
+
+        std::unordered_map< QskAspect, HintAnimator > m_animatorMap;
+        std::unordered_map< int, HintAnimator > m_graphicFilterAnimatorMap;
+
+        /*
+            The update modes of the animated subcontrols. Windows, that
+            are opened while the transition is running, don't need to
+            resolve the hints again - the source skin might already be gone.
+         */
+        QHash< int, int > m_subcontrolUpdateModes;
+
         std::vector< WindowAnimator* > m_windowAnimators;
-        QMetaObject::Connection m_connections[2];
+
+        Clock m_clock;
+        QMetaObject::Connection m_connection;
     };
 }
 
 Q_GLOBAL_STATIC( ApplicationAnimator, qskApplicationAnimator )
 
+static inline int qskUpdateModes( const QskAspect aspect )
+{
+    int modes = UpdateInfo::Update;
+    if ( aspect.isMetric() )
+        modes |= UpdateInfo::Polish;
+
+    return modes;
+}
+
+Clock::Clock( ApplicationAnimator* animator )
+    : m_animator( animator )
+{
+}
+
+void Clock::start( QQuickWindow* window, const QskAnimationHint& hint )
+{
+    m_offset = 0.0;
+
+    m_curve.setType( hint.type );
+
+    setWindow( window );
+    setDuration( hint.duration );
+
+    QskAnimator::start();
+}
+
+void Clock::moveToWindow( QQuickWindow* window )
+{
+    if ( !isRunning() || window == this->window() )
+        return;
+
+    const auto elapsed = this->elapsed();
+    const auto progress = qBound( 0.0, elapsed / qreal( duration() ), 1.0 );
+
+    m_offset += ( 1.0 - m_offset ) * progress;
+
+    const int remaining = qMax( duration() - int( elapsed ), 1 );
+
+    setWindow( window ); // stops the clock
+    setDuration( remaining );
+
+    QskAnimator::start();
+}
+
+void Clock::advance( qreal value )
+{
+    m_animator->advance(
+        m_curve.valueForProgress( m_offset + ( 1.0 - m_offset ) * value ) );
+}
+
 WindowAnimator::WindowAnimator( QQuickWindow* window )
     : m_window( window )
 {
 }
 
-inline const QQuickWindow* WindowAnimator::window() const
+inline QQuickWindow* WindowAnimator::window() const
 {
     return m_window;
 }
 
-void WindowAnimator::start()
+void WindowAnimator::update()
 {
-    for ( auto& it : m_animatorMap )
-        it.second.start();
+    for ( auto& info : m_updateInfos )
+    {
+        if ( auto control = info.control )
+        {
+            if ( info.updateModes & UpdateInfo::Polish )
+            {
+                control->resetImplicitSize();
+                control->polish();
+            }
 
-    for ( auto& it : m_graphicFilterAnimatorMap )
-        it.second.start();
+            if ( info.updateModes & UpdateInfo::Update )
+                control->update();
+        }
+    }
 }
 
-bool WindowAnimator::isRunning() const
+inline void WindowAnimator::storeUpdateInfo( const QskControl* control, int updateModes )
 {
-    if ( !m_animatorMap.empty() )
-    {
-        const auto& animator = m_animatorMap.begin()->second;
-        if ( animator.isRunning() )
-            return true;
-    }
+    UpdateInfo info;
+    info.control = const_cast< QskControl* >( control );
+    info.updateModes = updateModes;
 
-    if ( !m_graphicFilterAnimatorMap.empty() )
-    {
-        const auto& animator = m_graphicFilterAnimatorMap.begin()->second;
-        if ( animator.isRunning() )
-            return true;
-    }
+    auto it = std::lower_bound(
+        m_updateInfos.begin(), m_updateInfos.end(), info, UpdateInfo::compare );
 
-    return false;
+    if ( ( it != m_updateInfos.end() ) && ( it->control == info.control ) )
+        it->updateModes |= info.updateModes;
+    else
+        m_updateInfos.insert( it, info );
+}
+
+ApplicationAnimator::ApplicationAnimator()
+    : m_clock( this )
+{
+}
+
+ApplicationAnimator::~ApplicationAnimator()
+{
+    reset();
 }
 
-inline QVariant WindowAnimator::animatedHint( QskAspect aspect ) const
+void ApplicationAnimator::setup(
+    const QskSkin* skin, const QskAnimationHint& animationHint )
 {
-    auto it = m_animatorMap.find( aspect );
-    if ( it != m_animatorMap.cend() )
+    m_skin = skin;
+    m_animationHint = animationHint;
+}
+
+inline WindowAnimator* ApplicationAnimator::windowAnimator(
+    const QQuickWindow* window ) const
+{
+    if ( window )
     {
-        const auto& animator = it->second;
-        if ( animator.isRunning() )
-            return animator.currentValue();
+        for ( auto animator : m_windowAnimators )
+        {
+            if ( animator->window() == window )
+                return animator;
+        }
     }
 
-    return QVariant();
+    return nullptr;
 }
 
-inline QVariant WindowAnimator::animatedGraphicFilter( int graphicRole ) const
+WindowAnimator* ApplicationAnimator::insertWindowAnimator( QQuickWindow* window )
 {
-    auto it = m_graphicFilterAnimatorMap.find( graphicRole );
-    if ( it != m_graphicFilterAnimatorMap.cend() )
+    auto animator = new WindowAnimator( window );
+    m_windowAnimators.push_back( animator );
+
+    connect( window, &QWindow::visibleChanged,
+        this, [ this, window ]( bool on ) { if ( !on ) removeWindow( window ); } );
+
+    connect( window, &QObject::destroyed,
+        this, [ this, window ]( QObject* ) { removeWindow( window ); } );
+
+    return animator;
+}
+
+void ApplicationAnimator::removeWindow( QQuickWindow* window )
+{
+    for ( auto it = m_windowAnimators.begin();
+        it != m_windowAnimators.end(); ++it )
     {
-        const auto& animator = it->second;
-        if ( animator.isRunning() )
-            return animator.currentValue();
+        if ( ( *it )->window() == window )
+        {
+            delete *it;
+            m_windowAnimators.erase( it );
+
+            break;
+        }
     }
 
-    return QVariant();
+    window->disconnect( this );
+
+    if ( m_clock.window() == window )
+    {
+        // the clock continues in one of the other windows
+
+        for ( auto animator : m_windowAnimators )
+        {
+            auto w = animator->window();
+            if ( w && w->isVisible() )
+            {
+                m_clock.moveToWindow( w );
+                return;
+            }
+        }
+
+        reset();
+    }
 }
 
-void WindowAnimator::addGraphicFilterAnimators( const QskAnimationHint& animatorHint,
+void ApplicationAnimator::addGraphicFilterAnimators(
     const QskSkin* skin1, const QskSkin* skin2 )
 {
     const QskColorFilter noFilter;
@@ -273,21 +430,23 @@ void WindowAnimator::addGraphicFilterAnimators( const QskAnimationHint& animator
 
         if ( f1 != f2 )
         {
-            QskVariantAnimator animator;
-            animator.setWindow( m_window );
-            animator.setDuration( animatorHint.duration );
-            animator.setEasingCurve( animatorHint.type );
-            animator.setStartValue( QVariant::fromValue( f1 ) );
-            animator.setEndValue( QVariant::fromValue( f2 ) );
-
-            m_graphicFilterAnimatorMap.emplace( it2->first, animator );
+            m_graphicFilterAnimatorMap.emplace( it2->first,
+                HintAnimator( QskAspect(), QVariant::fromValue( f1 ),
+                QVariant::fromValue( f2 ) ) );
         }
     }
 }
 
-void WindowAnimator::addItemAspects( QQuickItem* item,
-    const QskAnimationHint& animatorHint, const QSet< QskAspect >& candidates,
-    const QskSkin* skin1, const QskSkin* skin2  )
+void ApplicationAnimator::addWindow( QQuickWindow* window,
+    const QSet< QskAspect >& candidates, const QskSkin* skin1, const QskSkin* skin2 )
+{
+    auto animator = insertWindowAnimator( window );
+    addItemAspects( animator, window->contentItem(), candidates, skin1, skin2 );
+}
+
+void ApplicationAnimator::addItemAspects( WindowAnimator* animator,
+    QQuickItem* item, const QSet< QskAspect >& candidates,
+    const QskSkin* skin1, const QskSkin* skin2 )
 {
     if ( !item->isVisible() )
         return;
@@ -296,7 +455,7 @@ void WindowAnimator::addItemAspects( QQuickItem* item,
     {
         if ( control->isInitiallyPainted() && ( control->effectiveSkin() == skin2 ) )
         {
-            addHints( control, animatorHint, candidates, skin1, skin2 );
+            addHints( animator, control, candidates, skin1, skin2 );
 #if 1
             /*
                 As it is hard to identify which controls depend on the animated
@@ -310,29 +469,51 @@ void WindowAnimator::addItemAspects( QQuickItem* item,
 
     const auto children = item->childItems();
     for ( auto child : children )
-        addItemAspects( child, animatorHint, candidates, skin1, skin2 );
+        addItemAspects( animator, child, candidates, skin1, skin2 );
 }
 
-void WindowAnimator::update()
+void ApplicationAnimator::addItemUpdates( WindowAnimator* animator, QQuickItem* item )
 {
-    for ( auto& info : m_updateInfos )
+    if ( !item->isVisible() )
+        return;
+
+    if ( auto control = qskControlCast( item ) )
     {
-        if ( auto control = info.control )
+        if ( control->isInitiallyPainted() && ( control->effectiveSkin() == m_skin ) )
         {
-            if ( info.updateModes & UpdateInfo::Polish )
+            const bool hasContents = control->flags() & QQuickItem::ItemHasContents;
+
+            auto subControls = control->subControls();
+            subControls += QskAspect::NoSubcontrol;
+
+            int updateModes = 0;
+
+            for ( const auto subControl : qAsConst( subControls ) )
             {
-                control->resetImplicitSize();
-                control->polish();
+                if ( subControl != control->effectiveSubcontrol( subControl ) )
+                    continue;
+
+                const int modes = m_subcontrolUpdateModes.value( subControl, 0 );
+
+                // see isControlAffected
+                if ( hasContents || ( modes & UpdateInfo::Polish ) )
+                    updateModes |= modes;
             }
 
-            if ( info.updateModes & UpdateInfo::Update )
-                control->update();
+            if ( updateModes )
+                animator->storeUpdateInfo( control, updateModes );
+
+            control->update();
         }
     }
+
+    const auto children = item->childItems();
+    for ( auto child : children )
+        addItemUpdates( animator, child );
 }
 
-void WindowAnimator::addHints( const QskControl* control,
-    const QskAnimationHint& animatorHint, const QSet< QskAspect >& candidates,
+void ApplicationAnimator::addHints( WindowAnimator* animator,
+    const QskControl* control, const QSet< QskAspect >& candidates,
     const QskSkin* skin1, const QskSkin* skin2 )
 {
     const auto subControls = control->subControls();
@@ -371,8 +552,8 @@ void WindowAnimator::addHints( const QskControl* control,
                 if ( r1.states() == r2.states() )
                     aspect.setStates( r2.states() );
 
-                storeAnimator( control, aspect, *v1, *v2, animatorHint );
-                storeUpdateInfo( control, aspect );
+                storeAnimator( aspect, *v1, *v2 );
+                storeUpdateInfo( animator, control, aspect );
             }
         }
         else if ( v1 )
@@ -380,21 +561,21 @@ void WindowAnimator::addHints( const QskControl* control,
             aspect.setPlacement( r1.placement() );
             aspect.setStates( r1.states() );
 
-            storeAnimator( control, aspect, *v1, QVariant(), animatorHint );
-            storeUpdateInfo( control, aspect );
+            storeAnimator( aspect, *v1, QVariant() );
+            storeUpdateInfo( animator, control, aspect );
         }
         else if ( v2 )
         {
             aspect.setPlacement( r1.placement() );
             aspect.setStates( r1.states() );
 
-            storeAnimator( control, aspect, QVariant(), *v2, animatorHint );
-            storeUpdateInfo( control, aspect );
+            storeAnimator( aspect, QVariant(), *v2 );
+            storeUpdateInfo( animator, control, aspect );
         }
     }
 }
 
-inline bool WindowAnimator::isControlAffected( const QskControl* control,
+inline bool ApplicationAnimator::isControlAffected( const QskControl* control,
     const QVector< QskAspect::Subcontrol >& subControls, const QskAspect aspect ) const
 {
     if ( !aspect.isMetric() )
@@ -428,121 +609,157 @@ inline bool WindowAnimator::isControlAffected( const QskControl* control,
     return true;
 }
 
-inline void WindowAnimator::storeAnimator( const QskControl* control, const QskAspect aspect,
-    const QVariant& value1, const QVariant& value2, QskAnimationHint hint )
+inline void ApplicationAnimator::storeAnimator( const QskAspect aspect,
+    const QVariant& value1, const QVariant& value2 )
 {
     if ( m_animatorMap.find( aspect ) == m_animatorMap.cend() )
-    {
-        m_animatorMap.emplace( aspect,
-            HintAnimator( control, aspect, value1, value2, hint ) );
-    }
+        m_animatorMap.emplace( aspect, HintAnimator( aspect, value1, value2 ) );
 }
 
-inline void WindowAnimator::storeUpdateInfo( const QskControl* control, QskAspect aspect )
+inline void ApplicationAnimator::storeUpdateInfo( WindowAnimator* animator,
+    const QskControl* control, QskAspect aspect )
 {
-    UpdateInfo info;
-    info.control = const_cast< QskControl* >( control );
+    const int modes = qskUpdateModes( aspect );
 
-    info.updateModes = UpdateInfo::Update;
-    if ( aspect.isMetric() )
-        info.updateModes |= UpdateInfo::Polish;
-
-    auto it = std::lower_bound(
-        m_updateInfos.begin(), m_updateInfos.end(), info, UpdateInfo::compare );
-
-    if ( ( it != m_updateInfos.end() ) && ( it->control == info.control ) )
-        it->updateModes |= info.updateModes;
-    else
-        m_updateInfos.insert( it, info );
+    animator->storeUpdateInfo( control, modes );
+    m_subcontrolUpdateModes[ aspect.subControl() ] |= modes;
 }
 
-ApplicationAnimator::~ApplicationAnimator()
+void ApplicationAnimator::start()
 {
-    reset();
+    if ( m_windowAnimators.empty() )
+    {
+        reset();
+        return;
+    }
+
+    for ( auto& it : m_animatorMap )
+        it.second.prepare( 0.0 );
+
+    for ( auto& it : m_graphicFilterAnimatorMap )
+        it.second.prepare( 0.0 );
+
+    m_connection = QskAnimator::addCleanupHandler(
+        this, SLOT(cleanup(QQuickWindow*)), Qt::UniqueConnection );
+
+    m_clock.start( m_windowAnimators.front()->window(), m_animationHint );
 }
 
-inline WindowAnimator* ApplicationAnimator::windowAnimator( const QQuickWindow* window )
+void ApplicationAnimator::reset()
 {
-    if ( window )
+    m_clock.stop();
+
+    for ( auto animator : m_windowAnimators )
     {
-        for ( auto animator : m_windowAnimators )
-        {
-            if ( animator->window() == window )
-                return animator;
-        }
+        animator->window()->disconnect( this );
+        delete animator;
     }
 
-    return nullptr;
+    m_windowAnimators.clear();
+
+    m_animatorMap.clear();
+    m_graphicFilterAnimatorMap.clear();
+    m_subcontrolUpdateModes.clear();
+
+    m_skin = nullptr;
+
+    disconnect( m_connection );
 }
 
-void ApplicationAnimator::add( WindowAnimator* animator )
+inline bool ApplicationAnimator::isRunning() const
 {
-    m_windowAnimators.push_back( animator );
+    return !m_windowAnimators.empty();
 }
 
-void ApplicationAnimator::start()
+void ApplicationAnimator::advance( qreal progress )
 {
-    m_connections[0] = QskAnimator::addAdvanceHandler(
-        this, SLOT(notify(QQuickWindow*)), Qt::UniqueConnection );
+    addPendingWindows();
 
-    m_connections[1] = QskAnimator::addCleanupHandler(
-        this, SLOT(cleanup(QQuickWindow*)), Qt::UniqueConnection );
+    for ( auto& it : m_animatorMap )
+        it.second.advance( progress );
 
-    for ( auto& animator : m_windowAnimators )
-        animator->start();
+    for ( auto& it : m_graphicFilterAnimatorMap )
+        it.second.advance( progress );
+
+    for ( auto animator : m_windowAnimators )
+        animator->update();
 }
 
-void ApplicationAnimator::reset()
+void ApplicationAnimator::addPendingWindows()
 {
-    qDeleteAll( m_windowAnimators );
-    m_windowAnimators.clear();
+    // windows, that have been opened while the transition is running
 
-    disconnect( m_connections[0] );
-    disconnect( m_connections[1] );
+    const auto windows = qGuiApp->topLevelWindows();
+
+    for ( const auto window : windows )
+    {
+        if ( auto w = qobject_cast< QQuickWindow* >( window ) )
+        {
+            if ( w->isVisible() && ( windowAnimator( w ) == nullptr )
+                && ( qskEffectiveSkin( w ) == m_skin ) )
+            {
+                auto animator = insertWindowAnimator( w );
+                addItemUpdates( animator, w->contentItem() );
+            }
+        }
+    }
 }
 
-inline bool ApplicationAnimator::isRunning() const
+inline bool ApplicationAnimator::isAnimatedWindow( const QQuickWindow* window ) const
 {
-    return !m_windowAnimators.empty();
+    /*
+        Windows with the target skin, that have not been picked
+        up yet, are using the interpolated values as well.
+     */
+    return window && m_skin && ( qskEffectiveSkin( window ) == m_skin );
 }
 
-void ApplicationAnimator::notify( QQuickWindow* window )
+QVariant ApplicationAnimator::animatedHint(
+    const QQuickWindow* window, QskAspect aspect ) const
 {
-    for ( auto& animator : m_windowAnimators )
+    if ( isAnimatedWindow( window ) )
     {
-        if ( animator->window() == window )
-        {
-            animator->update();
-            return;
-        }
+        auto it = m_animatorMap.find( aspect );
+        if ( it != m_animatorMap.cend() )
+            return it->second.currentValue();
+    }
+
+    return QVariant();
+}
+
+QVariant ApplicationAnimator::animatedGraphicFilter(
+    const QQuickWindow* window, int graphicRole ) const
+{
+    if ( isAnimatedWindow( window ) )
+    {
+        auto it = m_graphicFilterAnimatorMap.find( graphicRole );
+        if ( it != m_graphicFilterAnimatorMap.cend() )
+            return it->second.currentValue();
     }
+
+    return QVariant();
 }
 
 void ApplicationAnimator::cleanup( QQuickWindow* window )
 {
-    for ( auto it = m_windowAnimators.begin();
-        it != m_windowAnimators.end(); ++it )
+    if ( window != m_clock.window() || m_clock.isRunning() )
     {
-        auto animator = *it;
-        if ( animator->window() == window )
-        {
-            if ( !animator->isRunning() )
-            {
-                // The notification might be for other animators
+        // The notification is for other animators
+        return;
+    }
 
-                m_windowAnimators.erase( it );
-                delete animator;
-            }
+    std::vector< QPointer< QQuickWindow > > windows;
+    for ( auto animator : m_windowAnimators )
+        windows.emplace_back( animator->window() );
 
-            // let the items know, that we are done
-            qskSendStyleEventRecursive( window->contentItem() );
+    reset();
 
-            break;
-        }
+    // let the items know, that we are done
+    for ( auto& w : windows )
+    {
+        if ( w )
+            qskSendStyleEventRecursive( w->contentItem() );
     }
-
-    if ( m_windowAnimators.empty() )
-        reset();
 }
 
 class QskSkinTransition::PrivateData
@@ -627,7 +844,11 @@ void QskSkinTransition::process()
 
     if ( !candidates.isEmpty() )
     {
-        bool doGraphicFilter = m_data->mask & QskSkinTransition::Color;
+        auto animator = qskApplicationAnimator();
+        animator->setup( skin2, m_data->animationHint );
+
+        if ( m_data->mask & QskSkinTransition::Color )
+            animator->addGraphicFilterAnimators( skin1, skin2 );
 
         const auto windows = qGuiApp->topLevelWindows();
 
@@ -640,29 +861,17 @@ void QskSkinTransition::process()
                     continue;
                 }
 
-                auto animator = new WindowAnimator( w );
-
-                if ( doGraphicFilter )
-                {
-                    animator->addGraphicFilterAnimators(
-                        m_data->animationHint, skin1, skin2 );
-
-                    doGraphicFilter = false;
-                }
-
                 /*
                    finally we schedule the animators the hard way by running
-                   over the the item trees.
+                   over the the item trees. Hints, that have already been
+                   found in another window, are shared.
                  */
 
-                animator->addItemAspects( w->contentItem(),
-                    m_data->animationHint, candidates, skin1, skin2 );
-
-                qskApplicationAnimator->add( animator );
+                animator->addWindow( w, candidates, skin1, skin2 );
             }
         }
 
-        qskApplicationAnimator->start();
+        animator->start();
     }
 
     // apply the changes
@@ -681,10 +890,7 @@ QVariant QskSkinTransition::animatedHint(
     const QQuickWindow* window, QskAspect aspect )
 {
     if ( qskApplicationAnimator.exists() )
-    {
-        if ( const auto animator = qskApplicationAnimator->windowAnimator( window ) )
-            return animator->animatedHint( aspect );
-    }
+        return qskApplicationAnimator->animatedHint( window, aspect );
 
     return QVariant();
 }
@@ -693,10 +899,7 @@ QVariant QskSkinTransition::animatedGraphicFilter(
     const QQuickWindow* window, int graphicRole )
 {
     if ( qskApplicationAnimator.exists() )
-    {
-        if ( const auto animator = qskApplicationAnimator->windowAnimator( window ) )
-            return animator->animatedGraphicFilter( graphicRole );
-    }
+        return qskApplicationAnimator->animatedGraphicFilter( window, graphicRole );
 
     return QVariant();
 }
@@ -20,6 +20,7 @@
 #include "QskFunctions.h"
 #include "QskGradient.h"
 #include "QskGraphicNode.h"
+#include "QskVectorGraphicNode.h"
 #include "QskGraphic.h"
 #include "QskRectangleNode.h"
 #include "QskSGNode.h"
@@ -32,6 +33,8 @@
 #include <qquickwindow.h>
 #include <qsgsimplerectnode.h>
 
+#include <atomic>
+
 QSK_QT_PRIVATE_BEGIN
 #include <private/qquickitem_p.h>
 QSK_QT_PRIVATE_END
@@ -123,16 +126,46 @@ static inline QSGNode* qskUpdateGraphicNode(
     if ( control == nullptr )
         return nullptr;
 
-    auto graphicNode = static_cast< QskGraphicNode* >( node );
-    if ( graphicNode == nullptr )
+    const auto r = qskSceneAlignedRect( control, rect );
+
+    if ( control->testUpdateFlag( QskControl::VectorGraphics ) )
+    {
+        QskVectorGraphicNode* vectorNode = nullptr;
+
+        if ( node && node->type() == QSGNode::TransformNodeType )
+            vectorNode = static_cast< QskVectorGraphicNode* >( node );
+
+        const bool isSupported = vectorNode ? vectorNode->canDisplay( graphic )
+            : QskVectorGraphicNode::isSupported( graphic );
+
+        if ( isSupported )
+        {
+            if ( vectorNode == nullptr )
+                vectorNode = new QskVectorGraphicNode();
+
+            vectorNode->setMirrored( mirrored );
+            vectorNode->setGraphic( graphic, colorFilter, r );
+
+            return vectorNode;
+        }
+    }
+
+    QskGraphicNode* graphicNode = nullptr;
+
+    if ( node && node->type() != QSGNode::TransformNodeType )
+        graphicNode = static_cast< QskGraphicNode* >( node );
+    else
         graphicNode = new QskGraphicNode();
 
     const bool useRaster = control->testUpdateFlag( QskControl::PreferRasterForTextures );
     graphicNode->setRenderHint( useRaster ? QskPaintedNode::Raster : QskPaintedNode::OpenGL );
+    graphicNode->setAsynchronous( control->testUpdateFlag( QskControl::AsynchronousTextures ) );
 
-    graphicNode->setMirrored( mirrored );
+    // the same icons are often displayed by many controls
+    graphicNode->setSharedTexture( true );
+    graphicNode->setAtlasTexture( control->testUpdateFlag( QskControl::AtlasTextures ) );
 
-    const auto r = qskSceneAlignedRect( control, rect );
+    graphicNode->setMirrored( mirrored );
     graphicNode->setGraphic( control->window(), graphic, colorFilter, r );
 
     return graphicNode;
@@ -226,11 +259,21 @@ static inline QSGNode* qskUpdateArcNode(
         arcNode = new QskArcNode();
 
     const auto r = qskSceneAlignedRect( control, rect );
-    arcNode->setArcData( r, absoluteMetrics, fillGradient, control->window() );
+    arcNode->setArcData( r, absoluteMetrics, fillGradient );
 
     return arcNode;
 }
 
+namespace
+{
+    /*
+        updateNode is called from the scene graph thread(s),
+        so we need atomics for the counters
+     */
+    std::atomic< quint64 > qskUpdatedRoles( 0 );
+    std::atomic< quint64 > qskSkippedRoles( 0 );
+}
+
 class QskSkinlet::PrivateData
 {
   public:
@@ -243,6 +286,9 @@ class QskSkinlet::PrivateData
     QskSkin* skin;
     QVector< quint8 > nodeRoles;
 
+    // indexed by the node role
+    QVector< QVector< QskAspect::Subcontrol > > nodeRoleSubcontrols;
+
     int animatorIndex = -1;
 
     bool ownedBySkinnable : 1;
@@ -290,6 +336,9 @@ int QskSkinlet::animatorIndex() const
 void QskSkinlet::setNodeRoles( const QVector< quint8 >& nodeRoles )
 {
     m_data->nodeRoles = nodeRoles;
+
+    // derived skinlets might reuse the roles for different purposes
+    m_data->nodeRoleSubcontrols.clear();
 }
 
 void QskSkinlet::appendNodeRoles( const QVector< quint8 >& nodeRoles )
@@ -302,6 +351,52 @@ const QVector< quint8 >& QskSkinlet::nodeRoles() const
     return m_data->nodeRoles;
 }
 
+void QskSkinlet::setNodeRoleSubcontrols( quint8 nodeRole,
+    const QVector< QskAspect::Subcontrol >& subControls )
+{
+    auto& roleSubcontrols = m_data->nodeRoleSubcontrols;
+
+    if ( nodeRole >= roleSubcontrols.size() )
+        roleSubcontrols.resize( nodeRole + 1 );
+
+    roleSubcontrols[ nodeRole ] = subControls;
+}
+
+QVector< QskAspect::Subcontrol > QskSkinlet::nodeRoleSubcontrols( quint8 nodeRole ) const
+{
+    return m_data->nodeRoleSubcontrols.value( nodeRole );
+}
+
+QskSkinlet::UpdateStatistics QskSkinlet::updateStatistics()
+{
+    UpdateStatistics statistics;
+    statistics.updatedRoles = qskUpdatedRoles.load( std::memory_order_relaxed );
+    statistics.skippedRoles = qskSkippedRoles.load( std::memory_order_relaxed );
+
+    return statistics;
+}
+
+void QskSkinlet::resetUpdateStatistics()
+{
+    qskUpdatedRoles.store( 0, std::memory_order_relaxed );
+    qskSkippedRoles.store( 0, std::memory_order_relaxed );
+}
+
+static inline bool qskIsRoleDirty( const QskSkinnable* skinnable,
+    const QVector< QskAspect::Subcontrol >& subControls )
+{
+    if ( subControls.isEmpty() )
+        return true;
+
+    for ( const auto subControl : subControls )
+    {
+        if ( skinnable->isSubcontrolDirty( subControl ) )
+            return true;
+    }
+
+    return false;
+}
+
 void QskSkinlet::updateNode( QskSkinnable* skinnable, QSGNode* parentNode ) const
 {
     using namespace QskSGNode;
@@ -329,15 +424,31 @@ void QskSkinlet::updateNode( QskSkinnable* skinnable, QSGNode* parentNode ) cons
         replaceChildNode( DebugRole, parentNode, oldNode, newNode );
     }
 
+    const auto control = skinnable->owningControl();
+    const bool isPartial = control && control->isUpdatePartial();
+
+    quint64 skipped = 0;
+
     for ( const auto nodeRole : qAsConst( m_data->nodeRoles ) )
     {
         Q_ASSERT( nodeRole < FirstReservedRole );
 
+        if ( isPartial && !qskIsRoleDirty( skinnable,
+            m_data->nodeRoleSubcontrols.value( nodeRole ) ) )
+        {
+            skipped++;
+            continue;
+        }
+
         oldNode = QskSGNode::findChildNode( parentNode, nodeRole );
         newNode = updateSubNode( skinnable, nodeRole, oldNode );
 
         replaceChildNode( nodeRole, parentNode, oldNode, newNode );
     }
+
+    qskSkippedRoles.fetch_add( skipped, std::memory_order_relaxed );
+    qskUpdatedRoles.fetch_add( m_data->nodeRoles.size() - skipped,
+        std::memory_order_relaxed );
 }
 
 QSGNode* QskSkinlet::updateBackgroundNode(
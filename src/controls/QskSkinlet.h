@@ -35,6 +35,14 @@ class QSK_EXPORT QskSkinlet
     Q_GADGET
 
   public:
+    class UpdateStatistics
+    {
+      public:
+        // node roles, that have been visited/skipped in updateNode
+        quint64 updatedRoles = 0;
+        quint64 skippedRoles = 0;
+    };
+
     Q_INVOKABLE QskSkinlet( QskSkin* = nullptr );
     virtual ~QskSkinlet();
 
@@ -67,6 +75,7 @@ class QSK_EXPORT QskSkinlet
         QskAspect::Subcontrol, int index ) const;
 
     const QVector< quint8 >& nodeRoles() const;
+    QVector< QskAspect::Subcontrol > nodeRoleSubcontrols( quint8 nodeRole ) const;
 
     void setOwnedBySkinnable( bool on );
     bool isOwnedBySkinnable() const;
@@ -75,6 +84,9 @@ class QSK_EXPORT QskSkinlet
     void resetAnimatorIndex();
     int animatorIndex() const;
 
+    static UpdateStatistics updateStatistics();
+    static void resetUpdateStatistics();
+
     // Helper functions for creating nodes
 
     static QSGNode* updateBoxNode( const QskSkinnable*, QSGNode*,
@@ -134,6 +146,16 @@ class QSK_EXPORT QskSkinlet
     void setNodeRoles( const QVector< quint8 >& );
     void appendNodeRoles( const QVector< quint8 >& );
 
+    /*
+        The subcontrols, whose hints are used for the nodes of a role.
+        When only some subcontrols are dirty ( see QskSkinnable::markSubcontrolDirty )
+        updateNode skips roles, that don't depend on any of them.
+        Roles without subcontrols are always updated.
+        setNodeRoles resets all role subcontrols.
+     */
+    void setNodeRoleSubcontrols( quint8 nodeRole,
+        const QVector< QskAspect::Subcontrol >& );
+
     virtual QSGNode* updateSubNode( const QskSkinnable*,
         quint8 nodeRole, QSGNode* ) const;
 
@@ -10,6 +10,7 @@
 #include "QskAspect.h"
 #include "QskColorFilter.h"
 #include "QskControl.h"
+#include "QskControlPrivate.h"
 #include "QskHintAnimator.h"
 #include "QskMargins.h"
 #include "QskSetup.h"
@@ -30,6 +31,7 @@
 #include <qfont.h>
 #include <qfontmetrics.h>
 #include <map>
+#include <unordered_map>
 
 #define DEBUG_MAP 0
 #define DEBUG_ANIMATOR 0
@@ -78,14 +80,6 @@ static inline bool qskMoveMetric( QskSkinnable* skinnable,
     return qskMoveMetric( skinnable, aspect, QVariant::fromValue( metric ) );
 }
 
-template< typename T >
-static inline T qskMetric( const QskSkinnable* skinnable,
-    QskAspect aspect, QskSkinHintStatus* status = nullptr )
-{
-    return skinnable->effectiveSkinHint(
-        aspect | QskAspect::Metric, status ).value< T >();
-}
-
 static inline bool qskSetColor( QskSkinnable* skinnable,
     const QskAspect aspect, const QVariant& color )
 {
@@ -112,12 +106,19 @@ static inline bool qskMoveColor( QskSkinnable* skinnable,
     return qskMoveColor( skinnable, aspect, QVariant::fromValue( color ) );
 }
 
-template< typename T >
-static inline T qskColor( const QskSkinnable* skinnable,
-    QskAspect aspect, QskSkinHintStatus* status = nullptr )
+static inline bool qskAffectsSubcontrolOnly( QskAspect aspect )
 {
-    return skinnable->effectiveSkinHint(
-        aspect | QskAspect::Color, status ).value< T >();
+    /*
+        Colors and positions have no effect on the geometry of
+        other subcontrols. Skinlets, that use the hints of one subcontrol
+        for the nodes of another one, need to declare this dependency:
+        see QskSkinlet::setNodeRoleSubcontrols
+     */
+
+    if ( aspect.isColor() )
+        return true;
+
+    return aspect.isMetric() && ( aspect.metricPrimitive() == QskAspect::Position );
 }
 
 static inline void qskTriggerUpdates( QskAspect aspect, QskControl* control )
@@ -184,7 +185,10 @@ static inline void qskTriggerUpdates( QskAspect aspect, QskControl* control )
         }
     }
 
-    control->update(); // always
+    if ( qskAffectsSubcontrolOnly( aspect ) )
+        control->markSubcontrolDirty( aspect.subControl() );
+    else
+        control->update();
 
     if ( maybeLayout && control->hasChildItems() )
     {
@@ -215,6 +219,119 @@ static inline QskAspect qskSubstitutedAspect(
     return aspect;
 }
 
+static inline const QVariant* qskStoredHint( const QskSkinHintTable& localTable,
+    const QskSkinHintTable& skinTable, QskAspect aspect, QskSkinHintStatus& status )
+{
+    QskAspect resolvedAspect;
+
+    if ( localTable.hasHints() )
+    {
+        if ( const auto value = localTable.resolvedHint( aspect, &resolvedAspect ) )
+        {
+            status.source = QskSkinHintStatus::Skinnable;
+            status.aspect = resolvedAspect;
+
+            return value;
+        }
+    }
+
+    // next we try the hints from the skin
+
+    if ( skinTable.hasHints() )
+    {
+        if ( const auto value = skinTable.resolvedHint( aspect, &resolvedAspect ) )
+        {
+            status.source = QskSkinHintStatus::Skin;
+            status.aspect = resolvedAspect;
+
+            return value;
+        }
+
+        if ( aspect.hasSubcontrol() )
+        {
+            // trying to resolve something from the skin default settings
+
+            aspect.clearSubcontrol();
+            aspect.clearStates();
+
+            if ( const auto value = skinTable.resolvedHint( aspect, &resolvedAspect ) )
+            {
+                status.source = QskSkinHintStatus::Skin;
+                status.aspect = resolvedAspect;
+
+                return value;
+            }
+        }
+    }
+
+    status.source = QskSkinHintStatus::NoSource;
+    status.aspect = QskAspect();
+
+    return nullptr;
+}
+
+namespace
+{
+    /*
+        Memoizing the results of resolving hints from the local and
+        the skin table. The values are pointers into the tables, that
+        stay valid as long as the generations of the tables do not change.
+     */
+    class HintCache
+    {
+      public:
+        struct Entry
+        {
+            const QVariant* value;
+            QskSkinHintStatus status;
+        };
+
+        inline const Entry* find( QskAspect aspect,
+            quint64 localGeneration, quint64 skinGeneration )
+        {
+            if ( localGeneration != m_localGeneration
+                || skinGeneration != m_skinGeneration )
+            {
+                m_entries.clear();
+
+                m_localGeneration = localGeneration;
+                m_skinGeneration = skinGeneration;
+            }
+
+            const auto it = m_entries.find( aspect );
+            if ( it != m_entries.cend() )
+            {
+                hits++;
+                return &it->second;
+            }
+
+            misses++;
+            return nullptr;
+        }
+
+        inline const Entry* insert( QskAspect aspect,
+            const QVariant* value, const QskSkinHintStatus& status )
+        {
+            const Entry entry = { value, status };
+            return &m_entries.emplace( aspect, entry ).first->second;
+        }
+
+        inline void clear()
+        {
+            m_entries.clear();
+        }
+
+        quint32 hits = 0;
+        quint32 misses = 0;
+
+      private:
+        quint64 m_localGeneration = 0;
+        quint64 m_skinGeneration = 0;
+
+        std::unordered_map< QskAspect, Entry > m_entries;
+    };
+}
+
 class QskSkinnable::PrivateData
 {
   public:
@@ -227,6 +344,7 @@ class QskSkinnable::PrivateData
         }
 
         delete subcontrolProxies;
+        delete hintCache;
     }
 
     QskSkinHintTable hintTable;
@@ -235,8 +353,13 @@ class QskSkinnable::PrivateData
     typedef std::map< QskAspect::Subcontrol, QskAspect::Subcontrol > ProxyMap;
     ProxyMap* subcontrolProxies = nullptr;
 
+    HintCache* hintCache = nullptr;
+
     const QskSkinlet* skinlet = nullptr;
 
+    // subcontrols, that have been marked dirty since the last updateNode
+    QVector< QskAspect::Subcontrol > dirtySubcontrols;
+
     QskAspect::States skinStates;
     bool hasLocalSkinlet = false;
 };
@@ -351,6 +474,49 @@ const QskSkinHintTable& QskSkinnable::hintTable() const
     return m_data->hintTable;
 }
 
+void QskSkinnable::setHintCacheEnabled( bool on )
+{
+    if ( on == isHintCacheEnabled() )
+        return;
+
+    if ( on )
+    {
+        m_data->hintCache = new HintCache();
+    }
+    else
+    {
+        delete m_data->hintCache;
+        m_data->hintCache = nullptr;
+    }
+}
+
+bool QskSkinnable::isHintCacheEnabled() const
+{
+    return m_data->hintCache != nullptr;
+}
+
+quint32 QskSkinnable::hintCacheHits() const
+{
+    return m_data->hintCache ? m_data->hintCache->hits : 0;
+}
+
+quint32 QskSkinnable::hintCacheMisses() const
+{
+    return m_data->hintCache ? m_data->hintCache->misses : 0;
+}
+
+template< typename T >
+T QskSkinnable::typedHint( QskAspect aspect, QskSkinHintStatus* status ) const
+{
+    QVariant buffer;
+    const auto& hint = effectiveHint( aspect, status, buffer );
+
+    if ( const auto value = qskHintData< T >( hint ) )
+        return *value;
+
+    return hint.value< T >();
+}
+
 bool QskSkinnable::setFlagHint( const QskAspect aspect, int flag )
 {
     return qskSetFlag( this, aspect, flag );
@@ -403,7 +569,7 @@ bool QskSkinnable::moveColor( const QskAspect aspect, QRgb rgb )
 
 QColor QskSkinnable::color( const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskColor< QColor >( this, aspect, status );
+    return typedHint< QColor >( aspect | QskAspect::Color, status );
 }
 
 bool QskSkinnable::setMetric( const QskAspect aspect, qreal metric )
@@ -418,7 +584,7 @@ bool QskSkinnable::moveMetric( QskAspect aspect, qreal metric )
 
 qreal QskSkinnable::metric( const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< qreal >( this, aspect, status );
+    return typedHint< qreal >( aspect | QskAspect::Metric, status );
 }
 
 bool QskSkinnable::setPositionHint( QskAspect aspect, qreal position )
@@ -444,7 +610,7 @@ bool QskSkinnable::resetPositionHint( QskAspect aspect )
 
 qreal QskSkinnable::positionHint( QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< qreal >( this, aspect | QskAspect::Position, status );
+    return typedHint< qreal >( aspect | QskAspect::Metric | QskAspect::Position, status );
 }
 
 bool QskSkinnable::setStrutSizeHint(
@@ -466,7 +632,8 @@ bool QskSkinnable::resetStrutSizeHint( const QskAspect aspect )
 QSizeF QskSkinnable::strutSizeHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< QSizeF >( this, aspect | QskAspect::StrutSize, status );
+    return typedHint< QSizeF >(
+        aspect | QskAspect::Metric | QskAspect::StrutSize, status );
 }
 
 bool QskSkinnable::setMarginHint( const QskAspect aspect, qreal margins )
@@ -487,7 +654,8 @@ bool QskSkinnable::resetMarginHint( const QskAspect aspect )
 QMarginsF QskSkinnable::marginHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< QskMargins >( this, aspect | QskAspect::Margin, status );
+    return typedHint< QskMargins >(
+        aspect | QskAspect::Metric | QskAspect::Margin, status );
 }
 
 bool QskSkinnable::setPaddingHint( const QskAspect aspect, qreal padding )
@@ -508,7 +676,8 @@ bool QskSkinnable::resetPaddingHint( const QskAspect aspect )
 QMarginsF QskSkinnable::paddingHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< QskMargins >( this, aspect | QskAspect::Padding, status );
+    return typedHint< QskMargins >(
+        aspect | QskAspect::Metric | QskAspect::Padding, status );
 }
 
 bool QskSkinnable::setGradientHint(
@@ -520,7 +689,7 @@ bool QskSkinnable::setGradientHint(
 QskGradient QskSkinnable::gradientHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskColor< QskGradient >( this, aspect, status );
+    return typedHint< QskGradient >( aspect | QskAspect::Color, status );
 }
 
 bool QskSkinnable::setBoxShapeHint(
@@ -537,8 +706,8 @@ bool QskSkinnable::resetBoxShapeHint( const QskAspect aspect )
 QskBoxShapeMetrics QskSkinnable::boxShapeHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< QskBoxShapeMetrics >(
-        this, aspect | QskAspect::Shape, status );
+    return typedHint< QskBoxShapeMetrics >(
+        aspect | QskAspect::Metric | QskAspect::Shape, status );
 }
 
 bool QskSkinnable::setBoxBorderMetricsHint(
@@ -555,8 +724,8 @@ bool QskSkinnable::resetBoxBorderMetricsHint( const QskAspect aspect )
 QskBoxBorderMetrics QskSkinnable::boxBorderMetricsHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< QskBoxBorderMetrics >(
-        this, aspect | QskAspect::Border, status );
+    return typedHint< QskBoxBorderMetrics >(
+        aspect | QskAspect::Metric | QskAspect::Border, status );
 }
 
 bool QskSkinnable::setBoxBorderColorsHint(
@@ -573,8 +742,8 @@ bool QskSkinnable::resetBoxBorderColorsHint( const QskAspect aspect )
 QskBoxBorderColors QskSkinnable::boxBorderColorsHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskColor< QskBoxBorderColors >(
-        this, aspect | QskAspect::Border, status );
+    return typedHint< QskBoxBorderColors >(
+        aspect | QskAspect::Color | QskAspect::Border, status );
 }
 
 bool QskSkinnable::setShadowMetricsHint(
@@ -591,8 +760,8 @@ bool QskSkinnable::resetShadowMetricsHint( QskAspect aspect )
 QskShadowMetrics QskSkinnable::shadowMetricsHint(
     QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< QskShadowMetrics >(
-        this, aspect | QskAspect::Shadow, status );
+    return typedHint< QskShadowMetrics >(
+        aspect | QskAspect::Metric | QskAspect::Shadow, status );
 }
 
 bool QskSkinnable::setShadowColorHint( QskAspect aspect, const QColor& color )
@@ -607,7 +776,7 @@ bool QskSkinnable::resetShadowColorHint( QskAspect aspect )
 
 QColor QskSkinnable::shadowColorHint( QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskColor< QColor >( this, aspect | QskAspect::Shadow, status );
+    return typedHint< QColor >( aspect | QskAspect::Color | QskAspect::Shadow, status );
 }
 
 QskBoxHints QskSkinnable::boxHints( QskAspect aspect ) const
@@ -632,8 +801,8 @@ bool QskSkinnable::resetArcMetricsHint( const QskAspect aspect )
 QskArcMetrics QskSkinnable::arcMetricsHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< QskArcMetrics >(
-        this, aspect | QskAspect::Shape, status );
+    return typedHint< QskArcMetrics >(
+        aspect | QskAspect::Metric | QskAspect::Shape, status );
 }
 
 bool QskSkinnable::setSpacingHint( const QskAspect aspect, qreal spacing )
@@ -649,7 +818,7 @@ bool QskSkinnable::resetSpacingHint( const QskAspect aspect )
 qreal QskSkinnable::spacingHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< qreal >( this, aspect | QskAspect::Spacing, status );
+    return typedHint< qreal >( aspect | QskAspect::Metric | QskAspect::Spacing, status );
 }
 
 bool QskSkinnable::setTextOptionsHint(
@@ -865,13 +1034,24 @@ bool QskSkinnable::resetSkinHint( QskAspect aspect )
 QVariant QskSkinnable::effectiveSkinHint(
     QskAspect aspect, QskSkinHintStatus* status ) const
 {
+    QVariant buffer;
+    return effectiveHint( aspect, status, buffer );
+}
+
+const QVariant& QskSkinnable::effectiveHint( QskAspect aspect,
+    QskSkinHintStatus* status, QVariant& buffer ) const
+{
+    /*
+        Hints from the tables are returned by reference, only
+        animated/interpolated values end up in the buffer.
+     */
     aspect.setSubcontrol( effectiveSubcontrol( aspect.subControl() ) );
 
     if ( !( aspect.isAnimator() || aspect.hasStates() ) )
     {
-        const auto v = animatedHint( aspect, status );
-        if ( v.isValid() )
-            return v;
+        buffer = animatedHint( aspect, status );
+        if ( buffer.isValid() )
+            return buffer;
     }
 
     if ( aspect.section() == QskAspect::Body )
@@ -889,9 +1069,9 @@ QVariant QskSkinnable::effectiveSkinHint(
             The skin has changed and the hints are interpolated
             between the old and the new one over time
          */
-        const auto v = interpolatedHint( aspect, status );
-        if ( v.isValid() )
-            return v;
+        buffer = interpolatedHint( aspect, status );
+        if ( buffer.isValid() )
+            return buffer;
     }
 
     return storedHint( aspect, status );
@@ -1015,68 +1195,37 @@ QVariant QskSkinnable::interpolatedHint(
 const QVariant& QskSkinnable::storedHint(
     QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    const auto skin = effectiveSkin();
-
-    QskAspect resolvedAspect;
+    static QVariant hintInvalid;
 
     const auto& localTable = m_data->hintTable;
-    if ( localTable.hasHints() )
-    {
-        if ( const auto value = localTable.resolvedHint( aspect, &resolvedAspect ) )
-        {
-            if ( status )
-            {
-                status->source = QskSkinHintStatus::Skinnable;
-                status->aspect = resolvedAspect;
-            }
-            return *value;
-        }
-    }
-
-    // next we try the hints from the skin
+    const auto& skinTable = effectiveSkin()->hintTable();
 
-    const auto& skinTable = skin->hintTable();
-    if ( skinTable.hasHints() )
+    if ( auto cache = m_data->hintCache )
     {
-        if ( const auto value = skinTable.resolvedHint( aspect, &resolvedAspect ) )
-        {
-            if ( status )
-            {
-                status->source = QskSkinHintStatus::Skin;
-                status->aspect = resolvedAspect;
-            }
+        auto entry = cache->find( aspect,
+            localTable.generation(), skinTable.generation() );
 
-            return *value;
-        }
-
-        if ( aspect.hasSubcontrol() )
+        if ( entry == nullptr )
         {
-            // trying to resolve something from the skin default settings
+            QskSkinHintStatus hintStatus;
+            const auto value = qskStoredHint( localTable, skinTable, aspect, hintStatus );
 
-            aspect.clearSubcontrol();
-            aspect.clearStates();
+            entry = cache->insert( aspect, value, hintStatus );
+        }
 
-            if ( const auto value = skinTable.resolvedHint( aspect, &resolvedAspect ) )
-            {
-                if ( status )
-                {
-                    status->source = QskSkinHintStatus::Skin;
-                    status->aspect = resolvedAspect;
-                }
+        if ( status )
+            *status = entry->status;
 
-                return *value;
-            }
-        }
+        return entry->value ? *entry->value : hintInvalid;
     }
 
+    QskSkinHintStatus hintStatus;
+    const auto value = qskStoredHint( localTable, skinTable, aspect, hintStatus );
+
     if ( status )
-    {
-        status->source = QskSkinHintStatus::NoSource;
-        status->aspect = QskAspect();
-    }
+        *status = hintStatus;
 
-    static QVariant hintInvalid;
-    return hintInvalid;
+    return value ? *value : hintInvalid;
 }
 
 bool QskSkinnable::hasSkinState( QskAspect::State state ) const
@@ -1282,6 +1431,9 @@ void QskSkinnable::setSkinStateFlag( QskAspect::State stateFlag, bool on )
 
 void QskSkinnable::replaceSkinStates( QskAspect::States newStates )
 {
+    if ( m_data->hintCache )
+        m_data->hintCache->clear();
+
     m_data->skinStates = newStates;
 }
 
@@ -1310,20 +1462,39 @@ void QskSkinnable::setSkinStates( QskAspect::States newStates )
         << skinStateAsPrintable( newState );
 #endif
 
-    if ( control && control->window() )
+    if ( m_data->hintCache )
+        m_data->hintCache->clear();
+
+    bool hintsAffected = false;
+
+    if ( control )
     {
+        auto mask = m_data->hintTable.states();
         if ( const auto skin = effectiveSkin() )
+            mask |= skin->hintTable().states();
+
+        hintsAffected = ( newStates & mask ) != ( m_data->skinStates & mask );
+
+        if ( hintsAffected )
         {
-            const auto mask = m_data->hintTable.states() | skin->hintTable().states();
-            if ( ( newStates & mask ) != ( m_data->skinStates & mask ) )
-            {
-                /*
-                    When there are no aspects for the changed state bits we know
-                    that there won't be any animated transitions
-                 */
+            /*
+                Metrics or fonts might be resolved differently for the new
+                states, so the cached constrained size hints are stale.
+             */
+            QskControlPrivate::resetSizeHintCache( control );
+        }
+    }
 
-                startHintTransitions( m_data->skinStates, newStates );
-            }
+    if ( control && control->window() )
+    {
+        if ( hintsAffected && effectiveSkin() )
+        {
+            /*
+                When there are no aspects for the changed state bits we know
+                that there won't be any animated transitions
+             */
+
+            startHintTransitions( m_data->skinStates, newStates );
         }
 
         if ( control->flags() & QQuickItem::ItemHasContents )
@@ -1439,6 +1610,38 @@ QskAspect::Section QskSkinnable::section() const
 void QskSkinnable::updateNode( QSGNode* parentNode )
 {
     effectiveSkinlet()->updateNode( this, parentNode );
+    m_data->dirtySubcontrols.clear();
+}
+
+void QskSkinnable::markSubcontrolDirty( QskAspect::Subcontrol subControl )
+{
+    auto control = owningControl();
+    if ( control == nullptr || !( control->flags() & QQuickItem::ItemHasContents ) )
+        return;
+
+    if ( subControl == QskAspect::Control )
+    {
+        control->update();
+        return;
+    }
+
+    auto& subControls = m_data->dirtySubcontrols;
+    if ( !subControls.contains( subControl ) )
+        subControls += subControl;
+
+    control->updatePartially();
+}
+
+bool QskSkinnable::isSubcontrolDirty( QskAspect::Subcontrol subControl ) const
+{
+    const auto control = owningControl();
+    if ( control == nullptr || !control->isUpdatePartial() )
+        return true;
+
+    const auto& subControls = m_data->dirtySubcontrols;
+
+    return subControls.contains( subControl )
+        || subControls.contains( effectiveSubcontrol( subControl ) );
 }
 
 QskAspect::Subcontrol QskSkinnable::effectiveSubcontrol(
@@ -129,6 +129,14 @@ class QSK_EXPORT QskSkinnable
 
     QskAspect::Subcontrol effectiveSubcontrol( QskAspect::Subcontrol ) const;
 
+    /*
+        Schedules an update, that affects the nodes of a subcontrol only.
+        Skinlets might skip updating nodes of other subcontrols, as long as
+        no other update has been requested. QskAspect::Control means all nodes.
+     */
+    void markSubcontrolDirty( QskAspect::Subcontrol );
+    bool isSubcontrolDirty( QskAspect::Subcontrol ) const;
+
     QskControl* controlCast();
     const QskControl* controlCast() const;
 
@@ -250,6 +258,12 @@ class QSK_EXPORT QskSkinnable
 
     const QskSkinHintTable& hintTable() const;
 
+    void setHintCacheEnabled( bool );
+    bool isHintCacheEnabled() const;
+
+    quint32 hintCacheHits() const;
+    quint32 hintCacheMisses() const;
+
     bool startHintTransitions( QskAspect::States, QskAspect::States, int index = -1 );
 
   protected:
@@ -270,6 +284,11 @@ class QSK_EXPORT QskSkinnable
     QVariant interpolatedHint( QskAspect, QskSkinHintStatus* ) const;
     const QVariant& storedHint( QskAspect, QskSkinHintStatus* = nullptr ) const;
 
+    const QVariant& effectiveHint( QskAspect,
+        QskSkinHintStatus*, QVariant& buffer ) const;
+
+    template< typename T > T typedHint( QskAspect, QskSkinHintStatus* ) const;
+
     class PrivateData;
     std::unique_ptr< PrivateData > m_data;
 };
@@ -251,7 +251,8 @@ void QskSlider::moveHandleTo( qreal value, const QskAnimationHint& hint )
         setPositionHint( Handle, pos );
     }
 
-    update();
+    // groove and panel are not affected
+    markSubcontrolDirty( Handle );
 }
 
 #include "moc_QskSlider.cpp"
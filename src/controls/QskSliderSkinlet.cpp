@@ -31,7 +31,16 @@ static inline QRectF qskInnerPanelRect(
 QskSliderSkinlet::QskSliderSkinlet( QskSkin* skin )
     : Inherited( skin )
 {
+    using Q = QskSlider;
+
     setNodeRoles( { PanelRole, GrooveRole, FillRole, HandleRole, RippleRole } );
+
+    // fill and ripple are following the position of the handle
+    setNodeRoleSubcontrols( PanelRole, { Q::Panel } );
+    setNodeRoleSubcontrols( GrooveRole, { Q::Groove } );
+    setNodeRoleSubcontrols( FillRole, { Q::Fill, Q::Handle } );
+    setNodeRoleSubcontrols( HandleRole, { Q::Handle } );
+    setNodeRoleSubcontrols( RippleRole, { Q::Ripple, Q::Handle } );
 }
 
 QskSliderSkinlet::~QskSliderSkinlet()
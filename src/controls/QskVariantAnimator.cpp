@@ -101,6 +101,143 @@ static inline QVariant qskConvertedVariant( const QVariant& from, QskMetaType ty
     return v;
 }
 
+namespace
+{
+    enum TypedTrack
+    {
+        NoTrack,
+
+        RealTrack,
+        ColorTrack,
+        MarginsTrack,
+        GradientTrack,
+        BoxShapeTrack,
+        BoxBorderMetricsTrack,
+        ShadowMetricsTrack,
+        ArcMetricsTrack
+    };
+}
+
+static int qskTypedTrack( int typeId )
+{
+    if ( typeId == QMetaType::Double )
+        return RealTrack;
+
+    if ( typeId == QMetaType::QColor )
+        return ColorTrack;
+
+    if ( typeId == qMetaTypeId< QskMargins >() )
+        return MarginsTrack;
+
+    if ( typeId == qMetaTypeId< QskGradient >() )
+        return GradientTrack;
+
+    if ( typeId == qMetaTypeId< QskBoxShapeMetrics >() )
+        return BoxShapeTrack;
+
+    if ( typeId == qMetaTypeId< QskBoxBorderMetrics >() )
+        return BoxBorderMetricsTrack;
+
+    if ( typeId == qMetaTypeId< QskShadowMetrics >() )
+        return ShadowMetricsTrack;
+
+    if ( typeId == qMetaTypeId< QskArcMetrics >() )
+        return ArcMetricsTrack;
+
+    return NoTrack;
+}
+
+static inline int qskInterpolated( int from, int to, qreal progress )
+{
+    // the same calculation as the interpolator registered by Qt
+    return int( from + ( to - from ) * progress );
+}
+
+static inline QColor qskInterpolated( const QColor& from,
+    const QColor& to, qreal progress )
+{
+    return QColor(
+        qBound( 0, qskInterpolated( from.red(), to.red(), progress ), 255 ),
+        qBound( 0, qskInterpolated( from.green(), to.green(), progress ), 255 ),
+        qBound( 0, qskInterpolated( from.blue(), to.blue(), progress ), 255 ),
+        qBound( 0, qskInterpolated( from.alpha(), to.alpha(), progress ), 255 ) );
+}
+
+static inline qreal qskInterpolated( qreal from, qreal to, qreal progress )
+{
+    return from + ( to - from ) * progress;
+}
+
+template< typename T >
+static inline T qskInterpolated( const T& from, const T& to, qreal progress )
+{
+    return from.interpolated( to, progress );
+}
+
+template< typename T >
+static inline bool qskAdvanceTrack( const QVariant& from,
+    const QVariant& to, qreal progress, QVariant& value )
+{
+    /*
+        Writing into the payload of the current value: QVariant::data
+        only detaches, when the value is shared, what usually happens
+        only once - for the initial value.
+     */
+    const auto v = qskInterpolated( *static_cast< const T* >( from.constData() ),
+        *static_cast< const T* >( to.constData() ), progress );
+
+    if ( *static_cast< const T* >( value.constData() ) == v )
+        return false;
+
+    *static_cast< T* >( value.data() ) = v;
+    return true;
+}
+
+template<>
+inline bool qskAdvanceTrack< QskGradient >( const QVariant& from,
+    const QVariant& to, qreal progress, QVariant& value )
+{
+    // avoiding temporary stops by interpolating in place
+    static_cast< QskGradient* >( value.data() )->setInterpolated(
+        *static_cast< const QskGradient* >( from.constData() ),
+        *static_cast< const QskGradient* >( to.constData() ), progress );
+
+    return true;
+}
+
+static bool qskAdvanceTypedTrack( int track, const QVariant& from,
+    const QVariant& to, qreal progress, QVariant& value )
+{
+    switch( track )
+    {
+        case RealTrack:
+            return qskAdvanceTrack< qreal >( from, to, progress, value );
+
+        case ColorTrack:
+            return qskAdvanceTrack< QColor >( from, to, progress, value );
+
+        case MarginsTrack:
+            return qskAdvanceTrack< QskMargins >( from, to, progress, value );
+
+        case GradientTrack:
+            return qskAdvanceTrack< QskGradient >( from, to, progress, value );
+
+        case BoxShapeTrack:
+            return qskAdvanceTrack< QskBoxShapeMetrics >( from, to, progress, value );
+
+        case BoxBorderMetricsTrack:
+            return qskAdvanceTrack< QskBoxBorderMetrics >( from, to, progress, value );
+
+        case ShadowMetricsTrack:
+            return qskAdvanceTrack< QskShadowMetrics >( from, to, progress, value );
+
+        case ArcMetricsTrack:
+            return qskAdvanceTrack< QskArcMetrics >( from, to, progress, value );
+    }
+
+    return false;
+}
+
 QskVariantAnimator::QskVariantAnimator()
     : m_interpolator( nullptr )
 {
@@ -170,6 +307,7 @@ bool QskVariantAnimator::convertValues( QVariant& v1, QVariant& v2 )
 void QskVariantAnimator::setup()
 {
     m_interpolator = nullptr;
+    m_typedTrack = NoTrack;
 
     if ( convertValues( m_startValue, m_endValue ) )
     {
@@ -180,14 +318,20 @@ void QskVariantAnimator::setup()
             // all what has been registered by qRegisterAnimationInterpolator
             m_interpolator = reinterpret_cast< void ( * )() >(
                 QVariantAnimationPrivate::getInterpolator( id ) );
+
+            if ( m_interpolator )
+                m_typedTrack = qskTypedTrack( id );
         }
     }
 
     m_currentValue = m_interpolator ? m_startValue : m_endValue;
+    m_valueChanged = true;
 }
 
 void QskVariantAnimator::advance( qreal progress )
 {
+    m_valueChanged = false;
+
     if ( m_interpolator )
     {
         if ( qFuzzyCompare( progress, 1.0 ) )
@@ -195,14 +339,27 @@ void QskVariantAnimator::advance( qreal progress )
 
         Q_ASSERT( qskMetaType( m_startValue ) == qskMetaType( m_endValue ) );
 
-        m_currentValue = qskInterpolate( m_interpolator,
-            m_startValue, m_endValue, progress );
+        if ( m_typedTrack != NoTrack
+            && qskMetaType( m_currentValue ) == qskMetaType( m_startValue ) )
+        {
+            m_valueChanged = qskAdvanceTypedTrack( m_typedTrack,
+                m_startValue, m_endValue, progress, m_currentValue );
+        }
+        else
+        {
+            const auto value = qskInterpolate( m_interpolator,
+                m_startValue, m_endValue, progress );
+
+            m_valueChanged = ( value != m_currentValue );
+            m_currentValue = value;
+        }
     }
 }
 
 void QskVariantAnimator::done()
 {
     m_interpolator = nullptr;
+    m_typedTrack = NoTrack;
 }
 
 bool QskVariantAnimator::maybeInterpolate(
@@ -32,12 +32,22 @@ class QSK_EXPORT QskVariantAnimator : public QskAnimator
     void advance( qreal value ) override;
     void done() override;
 
+    // if the current value has been modified by the last call of advance
+    bool isValueChanged() const;
+
   private:
     QVariant m_startValue;
     QVariant m_endValue;
     QVariant m_currentValue;
 
     void ( *m_interpolator )();
+
+    /*
+        The most common types are interpolated in place, without
+        going through QVariant and the registered interpolators.
+     */
+    int m_typedTrack = 0;
+    bool m_valueChanged = false;
 };
 
 inline QVariant QskVariantAnimator::startValue() const
@@ -55,4 +65,9 @@ inline QVariant QskVariantAnimator::currentValue() const
     return m_currentValue;
 }
 
+inline bool QskVariantAnimator::isValueChanged() const
+{
+    return m_valueChanged;
+}
+
 #endif
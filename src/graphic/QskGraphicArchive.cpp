@@ -0,0 +1,650 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskGraphicArchive.h"
+#include "QskGraphic.h"
+#include "QskGraphicIO.h"
+#include "QskPainterCommand.h"
+
+#include <qbytearray.h>
+#include <qendian.h>
+#include <qfile.h>
+#include <qpainterpath.h>
+
+#include <algorithm>
+#include <cstring>
+
+static const char qskArchiveMagicNumber[] = "QSKA";
+static const quint16 qskArchiveVersion = 1;
+
+namespace
+{
+    /*
+        All values are stored in little endian. Tables and arrays
+        are aligned to 4 bytes. Vertices are stored as double, so that
+        nothing gets lost compared to the qreal values of a .qvg file.
+
+        Header:
+
+             0: magic number "QSKA"
+             4: quint16 version
+             6: quint16 flags
+             8: quint32 number of graphics
+            12: quint32 offset of the graphic table
+            16: quint32 offset of the command table
+            20: quint32 number of commands
+            24: quint32 offset of the vertex array ( double x, y )
+            28: quint32 offset of the element array ( quint8 types )
+            32: quint32 number of vertices/elements
+            36: quint32 offset of the blob area
+            40: quint32 size of the blob area
+            44: quint32 offset of the name table
+            48: quint32 offset of the string pool
+
+        Graphic: quint32 first command, quint32 number of commands
+
+        Command: quint8 type, quint8 fill rule, quint16 reserved,
+            quint32 first element/blob offset, quint32 number of elements/blob size
+
+        Name: quint32 string offset, quint32 string size ( utf8 ), quint32 graphic
+            - sorted by the utf8 strings
+     */
+
+    enum HeaderFlag
+    {
+        HasNames = 1 << 0
+    };
+
+    enum
+    {
+        HeaderSize = 52,
+        GraphicEntrySize = 8,
+        CommandEntrySize = 12,
+        NameEntrySize = 12,
+        VertexSize = 2 * sizeof( double )
+    };
+}
+
+template< typename T >
+static inline void qskAppend( QByteArray& data, T value )
+{
+    const T v = qToLittleEndian( value );
+    data.append( reinterpret_cast< const char* >( &v ), sizeof( T ) );
+}
+
+static inline void qskAlign( QByteArray& data )
+{
+    while ( data.size() % 4 )
+        data.append( '\0' );
+}
+
+template< typename T >
+static inline T qskValue( const uchar* data, quint32 offset )
+{
+    return qFromLittleEndian< T >( data + offset );
+}
+
+static inline bool qskInRange( quint64 offset, quint64 size, quint64 total )
+{
+    return offset + size <= total;
+}
+
+static inline QPointF qskVertex( const uchar* vertices, quint32 index )
+{
+    const auto offset = index * VertexSize;
+
+    return QPointF( qskValue< double >( vertices, offset ),
+        qskValue< double >( vertices, offset + sizeof( double ) ) );
+}
+
+static QPainterPath qskPath( const uchar* types,
+    const uchar* vertices, quint32 count, Qt::FillRule fillRule )
+{
+    QPainterPath path;
+    path.reserve( count );
+    path.setFillRule( fillRule );
+
+    for ( quint32 i = 0; i < count; i++ )
+    {
+        switch ( types[ i ] )
+        {
+            case QPainterPath::MoveToElement:
+            {
+                path.moveTo( qskVertex( vertices, i ) );
+                break;
+            }
+            case QPainterPath::LineToElement:
+            {
+                path.lineTo( qskVertex( vertices, i ) );
+                break;
+            }
+            case QPainterPath::CurveToElement:
+            {
+                if ( i + 2 < count )
+                {
+                    path.cubicTo( qskVertex( vertices, i ),
+                        qskVertex( vertices, i + 1 ), qskVertex( vertices, i + 2 ) );
+
+                    i += 2;
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    return path;
+}
+
+class QskGraphicArchive::PrivateData
+{
+  public:
+    bool init( const uchar* mem, qint64 memSize )
+    {
+        if ( mem == nullptr || memSize < HeaderSize || memSize > 0xffffffff )
+            return false;
+
+        if ( std::memcmp( mem, qskArchiveMagicNumber, 4 ) != 0 )
+            return false;
+
+        if ( qskValue< quint16 >( mem, 4 ) != qskArchiveVersion )
+        {
+            qWarning( "QskGraphicArchive: unsupported version" );
+            return false;
+        }
+
+        const auto size = static_cast< quint32 >( memSize );
+
+        flags = qskValue< quint16 >( mem, 6 );
+        graphicCount = qskValue< quint32 >( mem, 8 );
+        graphicTable = qskValue< quint32 >( mem, 12 );
+        commandTable = qskValue< quint32 >( mem, 16 );
+        commandCount = qskValue< quint32 >( mem, 20 );
+        vertexArray = qskValue< quint32 >( mem, 24 );
+        elementArray = qskValue< quint32 >( mem, 28 );
+        elementCount = qskValue< quint32 >( mem, 32 );
+        blobArea = qskValue< quint32 >( mem, 36 );
+        blobSize = qskValue< quint32 >( mem, 40 );
+        nameTable = qskValue< quint32 >( mem, 44 );
+        stringPool = qskValue< quint32 >( mem, 48 );
+
+        bool ok = qskInRange( graphicTable,
+            quint64( graphicCount ) * GraphicEntrySize, size );
+
+        ok = ok && qskInRange( commandTable,
+            quint64( commandCount ) * CommandEntrySize, size );
+
+        ok = ok && qskInRange( vertexArray,
+            quint64( elementCount ) * VertexSize, size );
+
+        ok = ok && qskInRange( elementArray, elementCount, size );
+        ok = ok && qskInRange( blobArea, blobSize, size );
+
+        if ( ok && ( flags & HasNames ) )
+        {
+            ok = qskInRange( nameTable,
+                quint64( graphicCount ) * NameEntrySize, size );
+
+            ok = ok && ( stringPool <= size );
+        }
+
+        if ( !ok )
+        {
+            qWarning( "QskGraphicArchive: corrupted data" );
+            return false;
+        }
+
+        data = mem;
+        dataSize = size;
+
+        return true;
+    }
+
+    void reset()
+    {
+        if ( mapped )
+        {
+            file.unmap( mapped );
+            mapped = nullptr;
+        }
+
+        if ( file.isOpen() )
+            file.close();
+
+        buffer.clear();
+
+        data = nullptr;
+        dataSize = 0;
+        graphicCount = 0;
+    }
+
+    inline const uchar* nameEntry( int index ) const
+    {
+        return data + nameTable + index * NameEntrySize;
+    }
+
+    inline QByteArray utf8Name( const uchar* entry ) const
+    {
+        const auto offset = quint64( stringPool ) + qskValue< quint32 >( entry, 0 );
+        const auto size = qskValue< quint32 >( entry, 4 );
+
+        if ( !qskInRange( offset, size, dataSize ) )
+            return QByteArray();
+
+        return QByteArray::fromRawData(
+            reinterpret_cast< const char* >( data + offset ), size );
+    }
+
+    QFile file;
+    uchar* mapped = nullptr;
+
+    QByteArray buffer;
+
+    const uchar* data = nullptr;
+    quint32 dataSize = 0;
+
+    quint16 flags = 0;
+
+    quint32 graphicCount = 0;
+    quint32 graphicTable = 0;
+
+    quint32 commandTable = 0;
+    quint32 commandCount = 0;
+
+    quint32 vertexArray = 0;
+    quint32 elementArray = 0;
+    quint32 elementCount = 0;
+
+    quint32 blobArea = 0;
+    quint32 blobSize = 0;
+
+    quint32 nameTable = 0;
+    quint32 stringPool = 0;
+};
+
+QskGraphicArchive::QskGraphicArchive()
+    : m_data( new PrivateData() )
+{
+}
+
+QskGraphicArchive::~QskGraphicArchive()
+{
+}
+
+bool QskGraphicArchive::load( const QString& fileName )
+{
+    unload();
+
+    auto& file = m_data->file;
+
+    file.setFileName( fileName );
+    if ( !file.open( QIODevice::ReadOnly ) )
+    {
+        qWarning( "QskGraphicArchive::load can't open %s", qPrintable( fileName ) );
+        return false;
+    }
+
+    m_data->mapped = file.map( 0, file.size() );
+
+    if ( m_data->mapped )
+    {
+        if ( m_data->init( m_data->mapped, file.size() ) )
+            return true;
+    }
+    else
+    {
+        // f.e compressed resources can't be mapped
+        m_data->buffer = file.readAll();
+        file.close();
+
+        const auto& buffer = m_data->buffer;
+
+        if ( m_data->init( reinterpret_cast< const uchar* >(
+            buffer.constData() ), buffer.size() ) )
+        {
+            return true;
+        }
+    }
+
+    m_data->reset();
+    return false;
+}
+
+bool QskGraphicArchive::load( const QByteArray& data )
+{
+    unload();
+
+    // implicitly shared: no deep copy
+    m_data->buffer = data;
+
+    const auto& buffer = m_data->buffer;
+
+    if ( m_data->init( reinterpret_cast< const uchar* >(
+        buffer.constData() ), buffer.size() ) )
+    {
+        return true;
+    }
+
+    m_data->reset();
+    return false;
+}
+
+void QskGraphicArchive::unload()
+{
+    m_data->reset();
+}
+
+bool QskGraphicArchive::isValid() const
+{
+    return m_data->data != nullptr;
+}
+
+int QskGraphicArchive::count() const
+{
+    return static_cast< int >( m_data->graphicCount );
+}
+
+bool QskGraphicArchive::hasNames() const
+{
+    return isValid() && ( m_data->flags & HasNames );
+}
+
+QStringList QskGraphicArchive::names() const
+{
+    QStringList names;
+
+    if ( hasNames() )
+    {
+        const int count = this->count();
+
+        names.reserve( count );
+        for ( int i = 0; i < count; i++ )
+            names += QString();
+
+        for ( int i = 0; i < count; i++ )
+        {
+            const auto entry = m_data->nameEntry( i );
+
+            const auto index = qskValue< quint32 >( entry, 8 );
+            if ( index < m_data->graphicCount )
+                names[ index ] = QString::fromUtf8( m_data->utf8Name( entry ) );
+        }
+    }
+
+    return names;
+}
+
+QString QskGraphicArchive::nameAt( int index ) const
+{
+    if ( hasNames() && index >= 0 && index < count() )
+    {
+        for ( int i = 0; i < count(); i++ )
+        {
+            const auto entry = m_data->nameEntry( i );
+
+            if ( qskValue< quint32 >( entry, 8 ) == quint32( index ) )
+                return QString::fromUtf8( m_data->utf8Name( entry ) );
+        }
+    }
+
+    return QString();
+}
+
+int QskGraphicArchive::indexOf( const QString& name ) const
+{
+    if ( !hasNames() )
+        return -1;
+
+    const auto key = name.toUtf8();
+
+    // binary search on the sorted name table
+
+    int lower = 0;
+    int upper = count() - 1;
+
+    while ( lower <= upper )
+    {
+        const int mid = lower + ( upper - lower ) / 2;
+
+        const auto entry = m_data->nameEntry( mid );
+        const int cmp = qstrcmp( m_data->utf8Name( entry ), key );
+
+        if ( cmp == 0 )
+            return static_cast< int >( qskValue< quint32 >( entry, 8 ) );
+
+        if ( cmp < 0 )
+            lower = mid + 1;
+        else
+            upper = mid - 1;
+    }
+
+    return -1;
+}
+
+QskGraphic QskGraphicArchive::graphicAt( int index ) const
+{
+    const auto& d = *m_data;
+
+    if ( !isValid() || index < 0 || quint32( index ) >= d.graphicCount )
+        return QskGraphic();
+
+    const auto graphicEntry = d.data + d.graphicTable + index * GraphicEntrySize;
+
+    const auto first = qskValue< quint32 >( graphicEntry, 0 );
+    const auto count = qskValue< quint32 >( graphicEntry, 4 );
+
+    if ( !qskInRange( first, count, d.commandCount ) )
+        return QskGraphic();
+
+    const auto types = d.data + d.elementArray;
+    const auto vertices = d.data + d.vertexArray;
+
+    QVector< QskPainterCommand > commands;
+    commands.reserve( count );
+
+    for ( quint32 i = first; i < first + count; i++ )
+    {
+        const auto entry = d.data + d.commandTable + i * CommandEntrySize;
+
+        const auto type = entry[ 0 ];
+        const auto offset = qskValue< quint32 >( entry, 4 );
+        const auto size = qskValue< quint32 >( entry, 8 );
+
+        if ( type == QskPainterCommand::Path )
+        {
+            if ( !qskInRange( offset, size, d.elementCount ) )
+                return QskGraphic();
+
+            const auto fillRule = static_cast< Qt::FillRule >( entry[ 1 ] );
+
+            commands += QskPainterCommand( qskPath( types + offset,
+                vertices + offset * VertexSize, size, fillRule ) );
+        }
+        else
+        {
+            if ( !qskInRange( offset, size, d.blobSize ) )
+                return QskGraphic();
+
+            // no deep copy
+            const auto blob = QByteArray::fromRawData(
+                reinterpret_cast< const char* >( d.data + d.blobArea + offset ), size );
+
+            if ( !QskGraphicIO::readCommand( blob, commands ) )
+                return QskGraphic();
+        }
+    }
+
+    QskGraphic graphic;
+    graphic.setCommands( commands );
+
+    return graphic;
+}
+
+QskGraphic QskGraphicArchive::graphic( const QString& name ) const
+{
+    return graphicAt( indexOf( name ) );
+}
+
+bool QskGraphicArchive::write( const QVector< QskGraphic >& graphics,
+    const QStringList& names, const QString& fileName )
+{
+    QFile file( fileName );
+    if ( file.open( QIODevice::WriteOnly | QIODevice::Truncate ) == false )
+    {
+        qWarning( "QskGraphicArchive::write can't open %s", qPrintable( fileName ) );
+        return false;
+    }
+
+    return write( graphics, names, &file );
+}
+
+bool QskGraphicArchive::write( const QVector< QskGraphic >& graphics,
+    const QStringList& names, QIODevice* dev )
+{
+    if ( dev == nullptr )
+        return false;
+
+    if ( !names.isEmpty() && names.size() != graphics.size() )
+    {
+        qWarning( "QskGraphicArchive::write: number of names does not match" );
+        return false;
+    }
+
+    QByteArray graphicTable, commandTable, vertices, elements, blobs;
+
+    quint32 commandCount = 0;
+    quint32 elementCount = 0;
+
+    for ( const auto& graphic : graphics )
+    {
+        const auto& commands = graphic.commands();
+
+        qskAppend< quint32 >( graphicTable, commandCount );
+        qskAppend< quint32 >( graphicTable, commands.size() );
+
+        for ( const auto& command : commands )
+        {
+            qskAppend< quint8 >( commandTable, command.type() );
+
+            if ( command.type() == QskPainterCommand::Path )
+            {
+                const auto path = command.path();
+                const int count = path->elementCount();
+
+                qskAppend< quint8 >( commandTable, path->fillRule() );
+                qskAppend< quint16 >( commandTable, 0 );
+                qskAppend< quint32 >( commandTable, elementCount );
+                qskAppend< quint32 >( commandTable, count );
+
+                for ( int i = 0; i < count; i++ )
+                {
+                    const auto element = path->elementAt( i );
+
+                    elements.append( static_cast< char >( element.type ) );
+
+                    qskAppend< double >( vertices, element.x );
+                    qskAppend< double >( vertices, element.y );
+                }
+
+                elementCount += count;
+            }
+            else
+            {
+                const quint32 offset = blobs.size();
+
+                if ( !QskGraphicIO::writeCommand( command, blobs ) )
+                    return false;
+
+                qskAppend< quint8 >( commandTable, 0 );
+                qskAppend< quint16 >( commandTable, 0 );
+                qskAppend< quint32 >( commandTable, offset );
+                qskAppend< quint32 >( commandTable, blobs.size() - offset );
+            }
+
+            commandCount++;
+        }
+    }
+
+    QByteArray nameTable, stringPool;
+
+    if ( !names.isEmpty() )
+    {
+        QVector< QByteArray > utf8Names;
+        utf8Names.reserve( names.size() );
+
+        QVector< int > order;
+        order.reserve( names.size() );
+
+        for ( int i = 0; i < names.size(); i++ )
+        {
+            utf8Names += names[ i ].toUtf8();
+            order += i;
+        }
+
+        std::sort( order.begin(), order.end(),
+            [ &utf8Names ]( int i1, int i2 )
+            { return qstrcmp( utf8Names[ i1 ], utf8Names[ i2 ] ) < 0; } );
+
+        for ( const auto index : order )
+        {
+            const auto& name = utf8Names[ index ];
+
+            qskAppend< quint32 >( nameTable, stringPool.size() );
+            qskAppend< quint32 >( nameTable, name.size() );
+            qskAppend< quint32 >( nameTable, index );
+
+            stringPool += name;
+        }
+    }
+
+    qskAlign( elements );
+    qskAlign( blobs );
+
+    const quint32 graphicTableOffset = HeaderSize;
+    const quint32 commandTableOffset = graphicTableOffset + graphicTable.size();
+    const quint32 vertexOffset = commandTableOffset + commandTable.size();
+    const quint32 elementOffset = vertexOffset + vertices.size();
+    const quint32 blobOffset = elementOffset + elements.size();
+    const quint32 nameTableOffset = blobOffset + blobs.size();
+    const quint32 stringPoolOffset = nameTableOffset + nameTable.size();
+
+    QByteArray header;
+    header.reserve( HeaderSize );
+
+    header.append( qskArchiveMagicNumber, 4 );
+    qskAppend< quint16 >( header, qskArchiveVersion );
+    qskAppend< quint16 >( header, names.isEmpty() ? 0 : HasNames );
+    qskAppend< quint32 >( header, graphics.size() );
+    qskAppend< quint32 >( header, graphicTableOffset );
+    qskAppend< quint32 >( header, commandTableOffset );
+    qskAppend< quint32 >( header, commandCount );
+    qskAppend< quint32 >( header, vertexOffset );
+    qskAppend< quint32 >( header, elementOffset );
+    qskAppend< quint32 >( header, elementCount );
+    qskAppend< quint32 >( header, blobOffset );
+    qskAppend< quint32 >( header, blobs.size() );
+    qskAppend< quint32 >( header, names.isEmpty() ? 0 : nameTableOffset );
+    qskAppend< quint32 >( header, names.isEmpty() ? 0 : stringPoolOffset );
+
+    const QByteArray* sections[] =
+    {
+        &header, &graphicTable, &commandTable, &vertices,
+        &elements, &blobs, &nameTable, &stringPool
+    };
+
+    for ( const auto section : sections )
+    {
+        if ( dev->write( *section ) != section->size() )
+            return false;
+    }
+
+    return true;
+}
+
+bool QskGraphicArchive::isArchive( const QByteArray& data )
+{
+    return data.startsWith( qskArchiveMagicNumber );
+}
@@ -0,0 +1,69 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_GRAPHIC_ARCHIVE_H
+#define QSK_GRAPHIC_ARCHIVE_H
+
+#include "QskGlobal.h"
+
+#include <qstringlist.h>
+#include <qvector.h>
+#include <memory>
+
+class QskGraphic;
+class QIODevice;
+class QByteArray;
+
+/*
+    QskGraphicArchive is a container for many graphics ( f.e. an icon theme )
+    in one file. In opposite to the stream format of QskGraphicIO all
+    path data is stored in flat vertex/element arrays, that are shared
+    by all graphics of the archive, and can be accessed by offset.
+
+    An archive file is memory mapped and a graphic is only
+    decoded, when being requested. Only commands, that can't be stored
+    as vertex data ( pen/brush state, raster data ) are decoded from
+    a serialized blob.
+ */
+class QSK_EXPORT QskGraphicArchive
+{
+  public:
+    QskGraphicArchive();
+    ~QskGraphicArchive();
+
+    bool load( const QString& fileName );
+    bool load( const QByteArray& );
+
+    void unload();
+
+    bool isValid() const;
+    int count() const;
+
+    bool hasNames() const;
+    QStringList names() const;
+
+    QString nameAt( int index ) const;
+    int indexOf( const QString& name ) const;
+
+    QskGraphic graphicAt( int index ) const;
+    QskGraphic graphic( const QString& name ) const;
+
+    // names are optional: empty or of the same size as the graphics
+    static bool write( const QVector< QskGraphic >&,
+        const QStringList& names, const QString& fileName );
+
+    static bool write( const QVector< QskGraphic >&,
+        const QStringList& names, QIODevice* );
+
+    static bool isArchive( const QByteArray& );
+
+  private:
+    Q_DISABLE_COPY( QskGraphicArchive )
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
+};
+
+#endif
@@ -203,6 +203,83 @@ static inline void qskReadStateData(
     commands += QskPainterCommand( data );
 }
 
+static bool qskReadCommand(
+    QDataStream& s, QVector< QskPainterCommand >& commands )
+{
+    quint8 type;
+    s >> type;
+
+    switch ( type )
+    {
+        case QskPainterCommand::Path:
+        {
+            qskReadPathData( s, commands );
+            break;
+        }
+        case QskPainterCommand::Pixmap:
+        {
+            qskReadPixmapData( s, commands );
+            break;
+        }
+        case QskPainterCommand::Image:
+        {
+            qskReadImageData( s, commands );
+            break;
+        }
+        case QskPainterCommand::State:
+        {
+            qskReadStateData( s, commands );
+            break;
+        }
+        default:
+            return false;
+    }
+
+    return s.status() == QDataStream::Ok;
+}
+
+static bool qskWriteCommand(
+    const QskPainterCommand& command, QDataStream& s )
+{
+    s << static_cast< quint8 >( command.type() );
+
+    switch ( command.type() )
+    {
+        case QskPainterCommand::Path:
+        {
+            qskWritePathData( *command.path(), s );
+            break;
+        }
+        case QskPainterCommand::Pixmap:
+        {
+            qskWritePixmapData( *command.pixmapData(), s );
+            break;
+        }
+        case QskPainterCommand::Image:
+        {
+            qskWriteImageData( *command.imageData(), s );
+            break;
+        }
+        case QskPainterCommand::State:
+        {
+            qskWriteStateData( *command.stateData(), s );
+            break;
+        }
+        default:
+            return false;
+    }
+
+    return true;
+}
+
+static inline void qskInitStream( QDataStream& stream )
+{
+#if 1
+    stream.setVersion( qskDataStreamVersion );
+#endif
+    stream.setByteOrder( QDataStream::BigEndian );
+}
+
 QskGraphic QskGraphicIO::read( const QString& fileName )
 {
     QFile file( fileName );
@@ -229,10 +306,7 @@ QskGraphic QskGraphicIO::read( QIODevice* dev )
         return QskGraphic();
 
     QDataStream stream( dev );
-#if 1
-    stream.setVersion( qskDataStreamVersion );
-#endif
-    stream.setByteOrder( QDataStream::BigEndian );
+    qskInitStream( stream );
 
     char magicNumber[ 4 ];
     stream.readRawData( magicNumber, 4 );
@@ -250,34 +324,8 @@ QskGraphic QskGraphicIO::read( QIODevice* dev )
 
     for ( uint i = 0; i < numCommands; i++ )
     {
-        quint8 type;
-        stream >> type;
-
-        switch ( type )
-        {
-            case QskPainterCommand::Path:
-            {
-                qskReadPathData( stream, commands );
-                break;
-            }
-            case QskPainterCommand::Pixmap:
-            {
-                qskReadPixmapData( stream, commands );
-                break;
-            }
-            case QskPainterCommand::Image:
-            {
-                qskReadImageData( stream, commands );
-                break;
-            }
-            case QskPainterCommand::State:
-            {
-                qskReadStateData( stream, commands );
-                break;
-            }
-            default:
-                return QskGraphic();
-        }
+        if ( !qskReadCommand( stream, commands ) )
+            return QskGraphic();
     }
 
     QskGraphic graphic;
@@ -310,10 +358,7 @@ bool QskGraphicIO::write( const QskGraphic& graphic, QIODevice* dev )
         return false;
 
     QDataStream stream( dev );
-#if 1
-    stream.setVersion( qskDataStreamVersion );
-#endif
-    stream.setByteOrder( QDataStream::BigEndian );
+    qskInitStream( stream );
     stream.writeRawData( qskMagicNumber, 4 );
 
     const int numCommands = graphic.commands().size();
@@ -323,37 +368,40 @@ bool QskGraphicIO::write( const QskGraphic& graphic, QIODevice* dev )
 
     for ( int i = 0; i < numCommands; i++ )
     {
-        stream << static_cast< quint8 >( cmds[ i ].type() );
-
-        switch ( cmds[ i ].type() )
+        if ( !qskWriteCommand( cmds[ i ], stream ) )
         {
-            case QskPainterCommand::Path:
-            {
-                qskWritePathData( *cmds[ i ].path(), stream );
-                break;
-            }
-            case QskPainterCommand::Pixmap:
-            {
-                qskWritePixmapData( *cmds[ i ].pixmapData(), stream );
-                break;
-            }
-            case QskPainterCommand::Image:
-            {
-                qskWriteImageData( *cmds[ i ].imageData(), stream );
-                break;
-            }
-            case QskPainterCommand::State:
-            {
-                qskWriteStateData( *cmds[ i ].stateData(), stream );
-                break;
-            }
-            default:
-            {
-                // cleanup ???
-                return false;
-            }
+            // cleanup ???
+            return false;
         }
     }
 
     return true;
 }
+
+bool QskGraphicIO::readCommand( const QByteArray& data,
+    QVector< QskPainterCommand >& commands )
+{
+    QBuffer buffer;
+    buffer.setData( data );
+
+    if ( !buffer.open( QIODevice::ReadOnly ) )
+        return false;
+
+    QDataStream stream( &buffer );
+    qskInitStream( stream );
+
+    return qskReadCommand( stream, commands );
+}
+
+bool QskGraphicIO::writeCommand(
+    const QskPainterCommand& command, QByteArray& data )
+{
+    QBuffer buffer( &data );
+    if ( !buffer.open( QIODevice::WriteOnly | QIODevice::Append ) )
+        return false;
+
+    QDataStream stream( &buffer );
+    qskInitStream( stream );
+
+    return qskWriteCommand( command, stream );
+}
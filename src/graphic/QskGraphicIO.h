@@ -7,8 +7,10 @@
 #define QSK_GRAPHIC_IO_H
 
 #include "QskGlobal.h"
+#include <qvector.h>
 
 class QskGraphic;
+class QskPainterCommand;
 class QString;
 class QIODevice;
 class QByteArray;
@@ -22,6 +24,14 @@ namespace QskGraphicIO
     QSK_EXPORT bool write( const QskGraphic&, const QString& fileName );
     QSK_EXPORT bool write( const QskGraphic&, QByteArray& data );
     QSK_EXPORT bool write( const QskGraphic&, QIODevice* dev );
+
+    /*
+        Serialization of a single command, using the same encoding
+        as the graphic stream. Used by QskGraphicArchive for all
+        commands, that can't be stored as flat vertex data.
+     */
+    QSK_EXPORT bool readCommand( const QByteArray&, QVector< QskPainterCommand >& );
+    QSK_EXPORT bool writeCommand( const QskPainterCommand&, QByteArray& );
 }
 
 #endif
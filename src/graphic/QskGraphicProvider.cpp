@@ -5,19 +5,251 @@
 
 #include "QskGraphicProvider.h"
 #include "QskGraphic.h"
+#include "QskPainterCommand.h"
 #include "QskSetup.h"
 
 #include <qmutex.h>
-#include <qcache.h>
+#include <qset.h>
+#include <qwaitcondition.h>
+#include <qhash.h>
 #include <qdebug.h>
 #include <qurl.h>
 
+#include <limits>
+
+namespace
+{
+    class CacheInfo;
+
+    class CacheEntry
+    {
+      public:
+        CacheInfo* owner = nullptr;
+        QString id;
+
+        QskGraphic graphic;
+        int cost = 0;
+
+        // LRU list of all providers
+        CacheEntry* prev = nullptr;
+        CacheEntry* next = nullptr;
+    };
+
+    class CacheInfo
+    {
+      public:
+        QHash< QString, CacheEntry* > entries;
+
+        // graphics, that are currently loaded by some thread
+        QSet< QString > loading;
+
+        int maxCount = 100;
+        qint64 maxCost = -1;
+
+        qint64 cost = 0;
+
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 evictions = 0;
+    };
+
+    /*
+        One LRU list for the graphics of all providers, so that
+        the memory budget can be shared. All operations have to
+        be done with the mutex being locked.
+     */
+    class GraphicCache
+    {
+      public:
+        ~GraphicCache()
+        {
+            while ( head )
+            {
+                auto entry = head;
+                head = entry->next;
+
+                delete entry;
+            }
+        }
+
+        /*
+            The graphics are returned as copies, that are made with
+            the mutex being locked. As QskGraphic is implicitly shared
+            this is cheap and the caller is not affected, when the entry
+            gets evicted by another thread.
+         */
+
+        bool object( const CacheInfo* info, const QString& id, QskGraphic& graphic ) const
+        {
+            const auto entry = info->entries.value( id, nullptr );
+            if ( entry == nullptr )
+                return false;
+
+            graphic = entry->graphic;
+            return true;
+        }
+
+        bool lookup( CacheInfo* info, const QString& id, QskGraphic& graphic )
+        {
+            const auto entry = info->entries.value( id, nullptr );
+            if ( entry == nullptr )
+            {
+                info->misses++;
+                misses++;
+
+                return false;
+            }
+
+            info->hits++;
+            hits++;
+
+            unlink( entry );
+            prepend( entry );
+
+            graphic = entry->graphic;
+            return true;
+        }
+
+        void insert( CacheInfo* info, const QString& id, const QskGraphic& graphic )
+        {
+            auto entry = new CacheEntry();
+            entry->owner = info;
+            entry->id = id;
+            entry->graphic = graphic;
+            entry->cost = QskGraphicProvider::graphicCost( graphic )
+                + int( sizeof( CacheEntry ) ) + id.size() * int( sizeof( QChar ) );
+
+            info->entries.insert( id, entry );
+            info->cost += entry->cost;
+
+            cost += entry->cost;
+            count++;
+
+            prepend( entry );
+
+            trim( info );
+        }
+
+        void clear( CacheInfo* info )
+        {
+            for ( auto entry : qAsConst( info->entries ) )
+            {
+                unlink( entry );
+
+                cost -= entry->cost;
+                count--;
+
+                delete entry;
+            }
+
+            info->entries.clear();
+            info->cost = 0;
+        }
+
+        void trim( CacheInfo* info )
+        {
+            if ( info )
+            {
+                const auto exceeds = [ info ]()
+                {
+                    return ( info->entries.count() > info->maxCount )
+                        || ( info->maxCost >= 0 && info->cost > info->maxCost );
+                };
+
+                for ( auto entry = tail; entry && exceeds(); )
+                {
+                    const auto prev = entry->prev;
+
+                    if ( entry->owner == info )
+                        evict( entry );
+
+                    entry = prev;
+                }
+            }
+
+            for ( auto entry = tail; entry && cost > budget; )
+            {
+                const auto prev = entry->prev;
+                evict( entry );
+
+                entry = prev;
+            }
+        }
+
+        QMutex mutex;
+
+        // signaled, whenever a thread has finished loading a graphic
+        QWaitCondition loaded;
+
+        // default: 16 MB
+        qint64 budget = 16 * 1024 * 1024;
+
+        qint64 cost = 0;
+        int count = 0;
+
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 evictions = 0;
+
+      private:
+        void evict( CacheEntry* entry )
+        {
+            auto info = entry->owner;
+
+            unlink( entry );
+            info->entries.remove( entry->id );
+
+            info->cost -= entry->cost;
+            info->evictions++;
+
+            cost -= entry->cost;
+            count--;
+            evictions++;
+
+            delete entry;
+        }
+
+        void prepend( CacheEntry* entry )
+        {
+            entry->prev = nullptr;
+            entry->next = head;
+
+            if ( head )
+                head->prev = entry;
+
+            head = entry;
+
+            if ( tail == nullptr )
+                tail = entry;
+        }
+
+        void unlink( CacheEntry* entry )
+        {
+            if ( entry->prev )
+                entry->prev->next = entry->next;
+            else
+                head = entry->next;
+
+            if ( entry->next )
+                entry->next->prev = entry->prev;
+            else
+                tail = entry->prev;
+
+            entry->prev = entry->next = nullptr;
+        }
+
+        CacheEntry* head = nullptr;
+        CacheEntry* tail = nullptr;
+    };
+}
+
+Q_GLOBAL_STATIC( GraphicCache, qskGraphicCache )
+
 class QskGraphicProvider::PrivateData
 {
   public:
     // caching of graphics
-    QCache< QString, const QskGraphic > cache;
-    QMutex mutex;
+    CacheInfo cacheInfo;
 };
 
 QskGraphicProvider::QskGraphicProvider( QObject* parent )
@@ -28,6 +260,11 @@ QskGraphicProvider::QskGraphicProvider( QObject* parent )
 
 QskGraphicProvider::~QskGraphicProvider()
 {
+    if ( auto cache = qskGraphicCache() )
+    {
+        QMutexLocker locker( &cache->mutex );
+        cache->clear( &m_data->cacheInfo );
+    }
 }
 
 void QskGraphicProvider::setCacheSize( int size )
@@ -35,58 +272,218 @@ void QskGraphicProvider::setCacheSize( int size )
     if ( size < 0 )
         size = 0;
 
-    QMutexLocker locker( &m_data->mutex );
-    m_data->cache.setMaxCost( size );
+    auto cache = qskGraphicCache();
+
+    QMutexLocker locker( &cache->mutex );
+
+    auto info = &m_data->cacheInfo;
+    if ( info->maxCount != size )
+    {
+        info->maxCount = size;
+        cache->trim( info );
+    }
 }
 
 int QskGraphicProvider::cacheSize() const
 {
-    QMutexLocker locker( &m_data->mutex );
-    return m_data->cache.maxCost();
+    auto cache = qskGraphicCache();
+
+    QMutexLocker locker( &cache->mutex );
+    return m_data->cacheInfo.maxCount;
+}
+
+void QskGraphicProvider::setCacheMemoryLimit( qint64 limit )
+{
+    if ( limit < 0 )
+        limit = -1;
+
+    auto cache = qskGraphicCache();
+
+    QMutexLocker locker( &cache->mutex );
+
+    auto info = &m_data->cacheInfo;
+    if ( info->maxCost != limit )
+    {
+        info->maxCost = limit;
+        cache->trim( info );
+    }
+}
+
+qint64 QskGraphicProvider::cacheMemoryLimit() const
+{
+    auto cache = qskGraphicCache();
+
+    QMutexLocker locker( &cache->mutex );
+    return m_data->cacheInfo.maxCost;
 }
 
 void QskGraphicProvider::clearCache()
 {
-    QMutexLocker locker( &m_data->mutex );
-    m_data->cache.clear();
+    auto cache = qskGraphicCache();
+
+    QMutexLocker locker( &cache->mutex );
+    cache->clear( &m_data->cacheInfo );
 }
 
-const QskGraphic* QskGraphicProvider::requestGraphic( const QString& id ) const
+QskGraphicProvider::Statistics QskGraphicProvider::statistics() const
 {
-    const QskGraphic* graphic = nullptr;
+    auto cache = qskGraphicCache();
 
-    {
-        QMutexLocker locker( &m_data->mutex );
-        graphic = m_data->cache.object( id );
-    }
+    QMutexLocker locker( &cache->mutex );
+
+    const auto& info = m_data->cacheInfo;
+
+    Statistics statistics;
+    statistics.hits = info.hits;
+    statistics.misses = info.misses;
+    statistics.evictions = info.evictions;
+    statistics.count = info.entries.count();
+    statistics.cost = info.cost;
+
+    return statistics;
+}
+
+QskGraphic QskGraphicProvider::requestGraphic( const QString& id ) const
+{
+    auto cache = qskGraphicCache();
+    auto info = &m_data->cacheInfo;
+
+    QskGraphic graphic;
 
-    if ( graphic == nullptr )
     {
-        graphic = loadGraphic( id );
+        QMutexLocker locker( &cache->mutex );
+        if ( cache->lookup( info, id, graphic ) )
+            return graphic;
 
-        if ( graphic == nullptr )
+        /*
+            When another thread - f.e. a job of QskSetup::warmUp -
+            is loading the same graphic we wait for its result
+            instead of loading it twice.
+         */
+        while ( info->loading.contains( id ) )
         {
-            qWarning() << "QskGraphicProvider: can't load" << id;
-            return nullptr;
+            cache->loaded.wait( &cache->mutex );
+
+            if ( cache->object( info, id, graphic ) )
+                return graphic;
         }
 
+        info->loading += id;
+    }
+
+    const auto loadedGraphic = loadGraphic( id );
+
+    const bool isLoaded = ( loadedGraphic != nullptr );
+    if ( isLoaded )
+    {
+        graphic = *loadedGraphic;
+        delete loadedGraphic;
+    }
+
+    {
+        QMutexLocker locker( &cache->mutex );
+
+        info->loading.remove( id );
+
+        if ( isLoaded )
+            cache->insert( info, id, graphic );
+
+        cache->loaded.wakeAll();
+    }
+
+    if ( !isLoaded )
+        qWarning() << "QskGraphicProvider: can't load" << id;
+
+    return graphic;
+}
+
+void QskGraphicProvider::setCacheBudget( qint64 budget )
+{
+    auto cache = qskGraphicCache();
+
+    QMutexLocker locker( &cache->mutex );
+
+    budget = qMax( budget, qint64( 0 ) );
+    if ( cache->budget != budget )
+    {
+        cache->budget = budget;
+        cache->trim( nullptr );
+    }
+}
+
+qint64 QskGraphicProvider::cacheBudget()
+{
+    auto cache = qskGraphicCache();
+
+    QMutexLocker locker( &cache->mutex );
+    return cache->budget;
+}
+
+QskGraphicProvider::Statistics QskGraphicProvider::cacheStatistics()
+{
+    auto cache = qskGraphicCache();
+
+    QMutexLocker locker( &cache->mutex );
+
+    Statistics statistics;
+    statistics.hits = cache->hits;
+    statistics.misses = cache->misses;
+    statistics.evictions = cache->evictions;
+    statistics.count = cache->count;
+    statistics.cost = cache->cost;
+
+    return statistics;
+}
+
+int QskGraphicProvider::graphicCost( const QskGraphic& graphic )
+{
+    using Element = QPainterPath::Element;
+
+    qint64 cost = sizeof( QskGraphic );
+
+    for ( const auto& command : graphic.commands() )
+    {
+        cost += sizeof( QskPainterCommand );
+
+        switch ( command.type() )
         {
-            QMutexLocker locker( &m_data->mutex );
+            case QskPainterCommand::Path:
+            {
+                cost += sizeof( QPainterPath )
+                    + command.path()->elementCount() * sizeof( Element );
+                break;
+            }
+            case QskPainterCommand::Pixmap:
+            {
+                const auto& pixmap = command.pixmapData()->pixmap;
 
-            if( auto cached = m_data->cache.object( id ) )
+                cost += sizeof( QskPainterCommand::PixmapData )
+                    + qint64( pixmap.width() ) * pixmap.height() * pixmap.depth() / 8;
+                break;
+            }
+            case QskPainterCommand::Image:
             {
-                delete graphic;
-                graphic = cached;
+                cost += sizeof( QskPainterCommand::ImageData )
+                    + command.imageData()->image.sizeInBytes();
+                break;
             }
-            else
+            case QskPainterCommand::State:
             {
-                const int cost = 1; // TODO ...
-                m_data->cache.insert( id, graphic, cost );
+                const auto data = command.stateData();
+
+                cost += sizeof( QskPainterCommand::StateData );
+
+                if ( data->flags & QPaintEngine::DirtyClipPath )
+                    cost += data->clipPath.elementCount() * sizeof( Element );
+
+                break;
             }
+            default:
+                break;
         }
     }
 
-    return graphic;
+    return int( qMin( cost, qint64( std::numeric_limits< int >::max() ) ) );
 }
 
 void Qsk::addGraphicProvider(
@@ -120,12 +517,10 @@ QskGraphic Qsk::loadGraphic( const QUrl& url )
 
     const QString providerId = url.host();
 
-    const QskGraphic* graphic = nullptr;
-
     if ( const auto provider = qskSetup->graphicProvider( providerId ) )
-        graphic = provider->requestGraphic( imageId );
+        return provider->requestGraphic( imageId );
 
-    return graphic ? *graphic : nullGraphic;
+    return nullGraphic;
 }
 
 #include "moc_QskGraphicProvider.cpp"
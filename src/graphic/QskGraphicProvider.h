@@ -21,17 +21,61 @@ class QSK_EXPORT QskGraphicProvider : public QObject
     Q_PROPERTY( int cacheSize READ cacheSize WRITE setCacheSize )
 
   public:
+    class Statistics
+    {
+      public:
+        inline qreal hitRate() const
+        {
+            const auto lookups = hits + misses;
+            return lookups ? qreal( hits ) / lookups : 0.0;
+        }
+
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 evictions = 0;
+
+        // currently cached graphics and their estimated memory in bytes
+        int count = 0;
+        qint64 cost = 0;
+    };
+
     QskGraphicProvider( QObject* parent = nullptr );
     ~QskGraphicProvider() override;
 
+    // the maximum number of cached graphics of this provider
     void setCacheSize( int );
     int cacheSize() const;
 
+    /*
+        An estimated memory limit in bytes for the cached graphics
+        of this provider. A negative value means, that only the
+        global budget is relevant.
+     */
+    void setCacheMemoryLimit( qint64 );
+    qint64 cacheMemoryLimit() const;
+
     void clearCache();
 
-    const QskGraphic* requestGraphic( const QString& id ) const;
+    Statistics statistics() const;
+
+    // a null graphic, when the graphic can't be loaded
+    QskGraphic requestGraphic( const QString& id ) const;
+
+    /*
+        All providers share one memory budget ( in bytes ), where the least
+        recently used graphics are evicted first - regardless of the provider.
+     */
+    static void setCacheBudget( qint64 );
+    static qint64 cacheBudget();
+
+    // accumulated over all providers
+    static Statistics cacheStatistics();
+
+    // the estimated memory, that is needed for a graphic
+    static int graphicCost( const QskGraphic& );
 
   protected:
+    // the provider takes ownership of the returned graphic
     virtual const QskGraphic* loadGraphic( const QString& id ) const = 0;
 
     class PrivateData;
@@ -10,6 +10,10 @@
 #include <qfile.h>
 #include <qdir.h>
 #include <qdebug.h>
+#include <qcache.h>
+#include <qmutex.h>
+#include <qrunnable.h>
+#include <qthreadpool.h>
 
 #include <hunspell/hunspell.h>
 
@@ -86,11 +90,154 @@ namespace
 
 #endif
 
-class QskHunspellTextPredictor::PrivateData
+/*
+    Loading the dictionaries and looking up suggestions is done in
+    a worker thread. As Hunspell is not thread safe all jobs are
+    running sequentially in a pool with one thread only.
+ */
+class QskHunspellTextPredictor::Engine
 {
   public:
+    ~Engine()
+    {
+        Hunspell_destroy( hunspellHandle );
+    }
+
+    QMutex mutex;
+
+    // reset, when the predictor is deleted
+    QskHunspellTextPredictor* predictor = nullptr;
+
+    // requests with a lower serial have been superseded
+    quint64 serial = 0;
+
+    // results for recently requested texts
+    QCache< QString, QStringList > cache { 256 };
+
+    // only accessed from the worker thread
     Hunhandle* hunspellHandle = nullptr;
     QByteArray hunspellEncoding;
+};
+
+class QskHunspellTextPredictor::LoadJob final : public QRunnable
+{
+  public:
+    LoadJob( const std::shared_ptr< Engine >& engine,
+            const QString& affFile, const QString& dicFile )
+        : m_engine( engine )
+        , m_affFile( affFile )
+        , m_dicFile( dicFile )
+    {
+    }
+
+    void run() override
+    {
+        auto handle = Hunspell_create( m_affFile.toUtf8(), m_dicFile.toUtf8() );
+
+        m_engine->hunspellHandle = handle;
+        m_engine->hunspellEncoding = Hunspell_get_dic_encoding( handle );
+    }
+
+  private:
+    const std::shared_ptr< Engine > m_engine;
+    const QString m_affFile;
+    const QString m_dicFile;
+};
+
+class QskHunspellTextPredictor::SuggestJob final : public QRunnable
+{
+  public:
+    SuggestJob( const std::shared_ptr< Engine >& engine,
+            quint64 serial, const QString& text )
+        : m_engine( engine )
+        , m_serial( serial )
+        , m_text( text )
+    {
+    }
+
+    void run() override
+    {
+        {
+            QMutexLocker locker( &m_engine->mutex );
+
+            if ( m_engine->predictor == nullptr || m_engine->serial != m_serial )
+                return; // superseded
+        }
+
+        /*
+            Without dictionaries - not loaded yet or failed to load -
+            the empty result must not be cached
+         */
+        const bool hasDictionaries = m_engine->hunspellHandle != nullptr;
+
+        const auto candidates = suggestions();
+
+        QMutexLocker locker( &m_engine->mutex );
+
+        if ( hasDictionaries )
+            m_engine->cache.insert( m_text, new QStringList( candidates ) );
+
+        if ( auto predictor = m_engine->predictor )
+        {
+            const auto serial = m_serial;
+            const auto text = m_text;
+
+            QMetaObject::invokeMethod( predictor,
+                [ predictor, serial, text, candidates ]
+                { predictor->setPrediction( serial, text, candidates ); },
+                Qt::QueuedConnection );
+        }
+    }
+
+  private:
+    QStringList suggestions() const
+    {
+        auto handle = m_engine->hunspellHandle;
+        if ( handle == nullptr )
+            return QStringList();
+
+        StringConverter converter( m_engine->hunspellEncoding );
+
+        char** suggestions;
+
+        const int count = Hunspell_suggest( handle,
+            &suggestions, converter.toHunspell( m_text ).constData() );
+
+        QStringList candidates;
+        candidates.reserve( count );
+
+        for ( int i = 0; i < count; i++ )
+        {
+            const auto suggestion = converter.fromHunspell( suggestions[ i ] );
+
+            if ( suggestion.startsWith( m_text ) )
+                candidates.prepend( suggestion );
+            else
+                candidates.append( suggestion );
+        }
+
+        Hunspell_free_list( handle, &suggestions, count );
+
+        return candidates;
+    }
+
+    const std::shared_ptr< Engine > m_engine;
+    const quint64 m_serial;
+    const QString m_text;
+};
+
+class QskHunspellTextPredictor::PrivateData
+{
+  public:
+    PrivateData()
+        : engine( std::make_shared< Engine >() )
+    {
+        threadPool.setMaxThreadCount( 1 );
+    }
+
+    std::shared_ptr< Engine > engine;
+    QThreadPool threadPool;
+
     QStringList candidates;
     QLocale locale;
 };
@@ -101,6 +248,7 @@ QskHunspellTextPredictor::QskHunspellTextPredictor(
     , m_data( new PrivateData() )
 {
     m_data->locale = locale;
+    m_data->engine->predictor = this;
 
     // make sure we call virtual functions:
     QMetaObject::invokeMethod( this,
@@ -109,11 +257,24 @@ QskHunspellTextPredictor::QskHunspellTextPredictor(
 
 QskHunspellTextPredictor::~QskHunspellTextPredictor()
 {
-    Hunspell_destroy( m_data->hunspellHandle );
+    {
+        // running jobs will drop their results
+        QMutexLocker locker( &m_data->engine->mutex );
+        m_data->engine->predictor = nullptr;
+    }
+
+    m_data->threadPool.clear();
+    m_data->threadPool.waitForDone();
 }
 
 void QskHunspellTextPredictor::reset()
 {
+    {
+        // superseding any running request
+        QMutexLocker locker( &m_data->engine->mutex );
+        m_data->engine->serial++;
+    }
+
     if ( !m_data->candidates.isEmpty() )
     {
         m_data->candidates.clear();
@@ -155,51 +316,55 @@ void QskHunspellTextPredictor::loadDictionaries()
 
         if( !files.first.isEmpty() && !files.second.isEmpty() )
         {
-            m_data->hunspellHandle = Hunspell_create( files.first.toUtf8(), files.second.toUtf8() );
-            m_data->hunspellEncoding = Hunspell_get_dic_encoding( m_data->hunspellHandle );
-            break;
+            // parsing the files is done in the worker thread
+            m_data->threadPool.start(
+                new LoadJob( m_data->engine, files.first, files.second ) );
+
+            return;
         }
     }
 
-    if( !m_data->hunspellHandle )
-    {
-        qWarning() << "could not find Hunspell files for locale" << m_data->locale
-                   << "in the following directories:" << paths
-                   << ". Consider setting QSK_HUNSPELL_PATH to the directory "
-                   << "containing Hunspell .aff and .dic files.";
-    }
+    qWarning() << "could not find Hunspell files for locale" << m_data->locale
+               << "in the following directories:" << paths
+               << ". Consider setting QSK_HUNSPELL_PATH to the directory "
+               << "containing Hunspell .aff and .dic files.";
 }
 
 void QskHunspellTextPredictor::request( const QString& text )
 {
-    if( !m_data->hunspellHandle )
+    auto engine = m_data->engine.get();
+
+    quint64 serial;
+
     {
-        Q_EMIT predictionChanged( text, {} );
-        return;
-    }
+        QMutexLocker locker( &engine->mutex );
 
-    StringConverter converter( m_data->hunspellEncoding );
+        serial = ++engine->serial;
 
-    char** suggestions;
+        if ( const auto candidates = engine->cache.object( text ) )
+        {
+            // backspace or retyping
+            m_data->candidates = *candidates;
+            locker.unlock();
 
-    const int count = Hunspell_suggest( m_data->hunspellHandle,
-        &suggestions, converter.toHunspell( text ).constData() );
+            Q_EMIT predictionChanged( text, m_data->candidates );
+            return;
+        }
+    }
 
-    QStringList candidates;
-    candidates.reserve( count );
+    m_data->threadPool.start( new SuggestJob( m_data->engine, serial, text ) );
+}
 
-    for ( int i = 0; i < count; i++ )
+void QskHunspellTextPredictor::setPrediction(
+    quint64 serial, const QString& text, const QStringList& candidates )
+{
     {
-        const auto suggestion = converter.fromHunspell( suggestions[ i ] );
+        QMutexLocker locker( &m_data->engine->mutex );
 
-        if ( suggestion.startsWith( text ) )
-            candidates.prepend( suggestion );
-        else
-            candidates.append( suggestion );
+        if ( serial != m_data->engine->serial )
+            return; // a newer request is pending
     }
 
-    Hunspell_free_list( m_data->hunspellHandle, &suggestions, count );
-
     m_data->candidates = candidates;
     Q_EMIT predictionChanged( text, m_data->candidates );
 }
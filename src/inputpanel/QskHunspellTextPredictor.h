@@ -28,6 +28,11 @@ class QSK_EXPORT QskHunspellTextPredictor : public QskTextPredictor
 
   private:
     Q_INVOKABLE void loadDictionaries();
+    void setPrediction( quint64 serial, const QString&, const QStringList& );
+
+    class Engine;
+    class LoadJob;
+    class SuggestJob;
 
     class PrivateData;
     std::unique_ptr< PrivateData > m_data;
@@ -6,7 +6,11 @@
 #include "QskVirtualKeyboard.h"
 #include "QskPushButton.h"
 #include "QskTextOptions.h"
+#include "QskSkinlet.h"
+#include "QskEvent.h"
 
+#include <qbasictimer.h>
+#include <qevent.h>
 #include <qguiapplication.h>
 #include <qset.h>
 #include <qstylehints.h>
@@ -18,45 +22,6 @@ namespace
         RowCount = 5,
         ColumnCount = 12
     };
-
-    using KeyRow = int[ ColumnCount ];
-
-    class Button final : public QskPushButton
-    {
-      public:
-        Button( int row, int column, QskVirtualKeyboard* parent )
-            : QskPushButton( parent )
-            , m_row( row )
-            , m_column( column )
-        {
-            QskTextOptions options;
-            options.setFontSizeMode( QskTextOptions::VerticalFit );
-            setTextOptions( options );
-
-            setFocusPolicy( Qt::TabFocus );
-        }
-
-        QskAspect::Subcontrol substitutedSubcontrol(
-            QskAspect::Subcontrol subControl ) const override
-        {
-            auto keyBoard = static_cast< const QskVirtualKeyboard* >( parent() );
-
-            if ( subControl == QskPushButton::Panel )
-                return keyBoard->effectiveSubcontrol( QskVirtualKeyboard::ButtonPanel );
-
-            if ( subControl == QskPushButton::Text )
-                return keyBoard->effectiveSubcontrol( QskVirtualKeyboard::ButtonText );
-
-            return QskPushButton::substitutedSubcontrol( subControl );
-        }
-
-        int row() const { return m_row; }
-        int column() const { return m_column; }
-
-      private:
-        const int m_row;
-        const int m_column;
-    };
 }
 
 struct QskVirtualKeyboardLayouts
@@ -101,51 +66,6 @@ static constexpr const QskVirtualKeyboardLayouts qskKeyboardLayouts =
 };
 #undef LOWER
 
-static qreal qskKeyStretch( int key )
-{
-    switch ( key )
-    {
-        case Qt::Key_Backspace:
-        case Qt::Key_Shift:
-        case Qt::Key_CapsLock:
-            return 1.5;
-
-        case Qt::Key_Space:
-            return 3.5;
-
-        case Qt::Key_Return:
-        case Qt::Key_Mode_switch:
-
-        // Possibly smaller
-        default:
-            break;
-    }
-
-    return 1.0;
-}
-
-static qreal qskRowStretch( const KeyRow& keyRow )
-{
-    qreal stretch = 0;
-
-    for ( const auto& key : keyRow )
-    {
-        if ( !key )
-        {
-            continue;
-        }
-
-        stretch += qskKeyStretch( key );
-    }
-
-    if ( stretch == 0.0 )
-    {
-        stretch = ColumnCount;
-    }
-
-    return stretch;
-}
-
 static QString qskTextForKey( int key )
 {
     // Special cases
@@ -228,40 +148,31 @@ class QskVirtualKeyboard::PrivateData
     const QskVirtualKeyboardLayouts::Layout* currentLayout = nullptr;
     QskVirtualKeyboard::Mode mode = QskVirtualKeyboard::LowercaseMode;
 
-    QVector< Button* > keyButtons;
     QSet< int > keyCodes;
+
+    int pressedIndex = -1;
+    int focusedIndex = -1;
+
+    QBasicTimer repeatTimer;
+    int autoRepeatDelay = 500;
+    int autoRepeatInterval = 0;
 };
 
 QskVirtualKeyboard::QskVirtualKeyboard( QQuickItem* parent )
     : Inherited( parent )
     , m_data( new PrivateData )
 {
-    setPolishOnResize( true );
     initSizePolicy( QskSizePolicy::Expanding, QskSizePolicy::Constrained );
+    setAcceptedMouseButtons( Qt::LeftButton );
+    setFocusPolicy( Qt::TabFocus );
 
-    m_data->keyButtons.reserve( RowCount * ColumnCount );
+    QskTextOptions options;
+    options.setFontSizeMode( QskTextOptions::VerticalFit );
+    setTextOptionsHint( ButtonText, options );
 
-    const auto autoRepeatInterval =
+    m_data->autoRepeatInterval =
         1000 / QGuiApplication::styleHints()->keyboardAutoRepeatRate();
 
-    for ( int row = 0; row < RowCount; row++ )
-    {
-        for ( int col = 0; col < ColumnCount; col++ )
-        {
-            auto button = new Button( row, col, this );
-            button->installEventFilter( this );
-
-            button->setAutoRepeat( false );
-            button->setAutoRepeatDelay( 500 );
-            button->setAutoRepeatInterval( autoRepeatInterval );
-
-            connect( button, &QskPushButton::pressed,
-                this, &QskVirtualKeyboard::buttonPressed );
-
-            m_data->keyButtons += button;
-        }
-    }
-
     connect( this, &QskControl::localeChanged,
         this, &QskVirtualKeyboard::updateLocale );
 
@@ -295,6 +206,18 @@ QskVirtualKeyboard::Mode QskVirtualKeyboard::mode() const
     return m_data->mode;
 }
 
+void QskVirtualKeyboard::updateLayout()
+{
+    /*
+        The keys are laid out by the skinlet, when updating the nodes.
+        We only have to notify about the geometry of the focused key.
+     */
+    Inherited::updateLayout();
+
+    if ( m_data->focusedIndex >= 0 )
+        Q_EMIT focusIndicatorRectChanged();
+}
+
 QSizeF QskVirtualKeyboard::layoutSizeHint(
     Qt::SizeHint which, const QSizeF& constraint ) const
 {
@@ -329,79 +252,360 @@ QSizeF QskVirtualKeyboard::layoutSizeHint(
     return QSizeF( w, h );
 }
 
-void QskVirtualKeyboard::updateLayout()
+bool QskVirtualKeyboard::hasKey( int keyCode ) const
 {
-    const auto r = layoutRect();
-    if ( r.isEmpty() )
-        return;
+    return m_data->keyCodes.contains( keyCode );
+}
 
-    const auto spacing = spacingHint( Panel );
-    const auto totalVSpacing = ( RowCount - 1 ) * spacing;
+int QskVirtualKeyboard::rowCount() const
+{
+    return RowCount;
+}
 
-    const auto keyHeight = ( r.height() - totalVSpacing ) / RowCount;
+int QskVirtualKeyboard::columnCount() const
+{
+    return ColumnCount;
+}
+
+int QskVirtualKeyboard::keyCodeAt( int row, int column ) const
+{
+    if ( row < 0 || row >= RowCount || column < 0 || column >= ColumnCount )
+        return 0;
 
     const auto& keyCodes = ( *m_data->currentLayout )[ m_data->mode ];
+    return keyCodes.data[ row ][ column ];
+}
+
+QString QskVirtualKeyboard::textForKey( int keyCode ) const
+{
+    return qskTextForKey( keyCode );
+}
+
+int QskVirtualKeyboard::keyIndexAt( const QPointF& pos ) const
+{
+    return effectiveSkinlet()->sampleIndexAt( this,
+        contentsRect(), ButtonPanel, pos );
+}
+
+int QskVirtualKeyboard::pressedKeyIndex() const
+{
+    return m_data->pressedIndex;
+}
+
+int QskVirtualKeyboard::focusedKeyIndex() const
+{
+    return m_data->focusedIndex;
+}
+
+void QskVirtualKeyboard::setFocusedKeyIndex( int index )
+{
+    if ( index == m_data->focusedIndex )
+        return;
+
+    const int oldIndex = m_data->focusedIndex;
 
-    qreal yPos = r.top();
+    const auto oldStates1 = keyStates( oldIndex );
+    const auto oldStates2 = keyStates( index );
 
-    for ( int row = 0; row < RowCount; row++ )
+    m_data->focusedIndex = index;
+
+    startKeyTransition( oldIndex, oldStates1 );
+    startKeyTransition( index, oldStates2 );
+
+    update();
+
+    Q_EMIT focusIndicatorRectChanged();
+}
+
+QRectF QskVirtualKeyboard::focusIndicatorRect() const
+{
+    if ( m_data->focusedIndex >= 0 )
     {
-        const auto& keys = keyCodes.data[ row ];
+        return effectiveSkinlet()->sampleRect( this,
+            contentsRect(), ButtonPanel, m_data->focusedIndex );
+    }
 
-#if 1
-        // there should be a better way
-        auto totalHSpacing = -spacing;
-        if ( spacing )
+    return Inherited::focusIndicatorRect();
+}
+
+QskAspect::States QskVirtualKeyboard::keyStates( int index ) const
+{
+    if ( index < 0 )
+        return QskAspect::NoState;
+
+    return effectiveSkinlet()->sampleStates( this, ButtonPanel, index );
+}
+
+void QskVirtualKeyboard::startKeyTransition( int index, QskAspect::States oldStates )
+{
+    /*
+        The keys are no controls, so we have to start the animators
+        for the state transitions of a key sample manually.
+     */
+    if ( index >= 0 )
+    {
+        const auto newStates = keyStates( index );
+        if ( newStates != oldStates )
+            startHintTransitions( oldStates, newStates, index );
+    }
+}
+
+int QskVirtualKeyboard::nextKeyIndex( int index, bool forwards ) const
+{
+    // keys in reading order, skipping the positions without a key
+
+    const int step = forwards ? 1 : -1;
+
+    for ( int i = index + step; i >= 0 && i < RowCount * ColumnCount; i += step )
+    {
+        if ( keyCodeAt( i / ColumnCount, i % ColumnCount ) != 0 )
+            return i;
+    }
+
+    return -1;
+}
+
+int QskVirtualKeyboard::nextRowKeyIndex( int index, bool forwards ) const
+{
+    /*
+        The keys of the rows are not aligned to a grid, so we
+        look for the key that is horizontally closest
+     */
+
+    const int row = index / ColumnCount + ( forwards ? 1 : -1 );
+    if ( index < 0 || row < 0 || row >= RowCount )
+        return -1;
+
+    const auto skinlet = effectiveSkinlet();
+    const auto rect = contentsRect();
+
+    const auto x = skinlet->sampleRect( this, rect, ButtonPanel, index ).center().x();
+
+    int nextIndex = -1;
+    qreal minDistance = 0.0;
+
+    for ( int col = 0; col < ColumnCount; col++ )
+    {
+        if ( keyCodeAt( row, col ) == 0 )
+            continue;
+
+        const int i = row * ColumnCount + col;
+
+        const auto keyRect = skinlet->sampleRect( this, rect, ButtonPanel, i );
+        const auto distance = qAbs( keyRect.center().x() - x );
+
+        if ( nextIndex < 0 || distance < minDistance )
         {
-            for ( int col = 0; col < ColumnCount; col++ )
-            {
-                if ( keys[ col ] != 0 )
-                    totalHSpacing += spacing;
-            }
+            nextIndex = i;
+            minDistance = distance;
         }
-#endif
-        const auto baseKeyWidth = ( r.width() - totalHSpacing ) / qskRowStretch( keys );
-        qreal xPos = r.left();
+    }
+
+    return nextIndex;
+}
+
+void QskVirtualKeyboard::setPressedKeyIndex( int index )
+{
+    if ( index == m_data->pressedIndex )
+        return;
+
+    const int oldIndex = m_data->pressedIndex;
+
+    const auto oldStates1 = keyStates( oldIndex );
+    const auto oldStates2 = keyStates( index );
+
+    m_data->pressedIndex = index;
+
+    startKeyTransition( oldIndex, oldStates1 );
+    startKeyTransition( index, oldStates2 );
 
-        for ( int col = 0; col < ColumnCount; col++ )
+    bool autoRepeat = false;
+    if ( index >= 0 )
+        autoRepeat = qskIsAutorepeat( keyCodeAt( index / ColumnCount, index % ColumnCount ) );
+
+    if ( autoRepeat )
+        m_data->repeatTimer.start( m_data->autoRepeatDelay, this );
+    else
+        m_data->repeatTimer.stop();
+
+    update();
+}
+
+void QskVirtualKeyboard::mousePressEvent( QMouseEvent* event )
+{
+    const int index = keyIndexAt( qskMousePosition( event ) );
+    if ( index < 0 )
+    {
+        Inherited::mousePressEvent( event );
+        return;
+    }
+
+    setPressedKeyIndex( index );
+    triggerKey( keyCodeAt( index / ColumnCount, index % ColumnCount ) );
+}
+
+void QskVirtualKeyboard::mouseMoveEvent( QMouseEvent* event )
+{
+    if ( m_data->pressedIndex >= 0 )
+    {
+        if ( keyIndexAt( qskMousePosition( event ) ) != m_data->pressedIndex )
+            setPressedKeyIndex( -1 );
+    }
+}
+
+void QskVirtualKeyboard::mouseReleaseEvent( QMouseEvent* )
+{
+    setPressedKeyIndex( -1 );
+}
+
+void QskVirtualKeyboard::mouseUngrabEvent()
+{
+    setPressedKeyIndex( -1 );
+    Inherited::mouseUngrabEvent();
+}
+
+void QskVirtualKeyboard::keyPressEvent( QKeyEvent* event )
+{
+    const int index = m_data->focusedIndex;
+
+    switch ( event->key() )
+    {
+        case Qt::Key_Left:
+        case Qt::Key_Right:
+        case Qt::Key_Up:
+        case Qt::Key_Down:
         {
-            const int key = keys[ col ];
-            auto button = m_data->keyButtons[ row * ColumnCount + col ];
+            int nextIndex = -1;
 
-            button->setVisible( key != 0 );
+            if ( index < 0 )
+            {
+                nextIndex = nextKeyIndex( -1, true );
+            }
+            else if ( event->key() == Qt::Key_Left || event->key() == Qt::Key_Right )
+            {
+                nextIndex = nextKeyIndex( index, event->key() == Qt::Key_Right );
 
-            if ( button->isVisible() )
+                if ( nextIndex / ColumnCount != index / ColumnCount )
+                    nextIndex = -1; // don't wrap into another row
+            }
+            else
             {
-                const qreal keyWidth = baseKeyWidth * qskKeyStretch( key );
+                nextIndex = nextRowKeyIndex( index, event->key() == Qt::Key_Down );
+            }
 
-                const QRectF rect( xPos, yPos, keyWidth, keyHeight );
+            if ( nextIndex >= 0 )
+                setFocusedKeyIndex( nextIndex );
 
-                button->setGeometry( rect );
-                button->setAutoRepeat( qskIsAutorepeat( key ) );
-                button->setText( qskTextForKey( key ) );
+            return;
+        }
 
-                xPos += keyWidth + spacing;
+        case Qt::Key_Select:
+        case Qt::Key_Space:
+        case Qt::Key_Enter:
+        case Qt::Key_Return:
+        {
+            // auto repeating is done by the repeat timer
+            if ( index >= 0 && !event->isAutoRepeat() )
+            {
+                setPressedKeyIndex( index );
+                triggerKey( keyCodeAt( index / ColumnCount, index % ColumnCount ) );
             }
+
+            return;
         }
 
-        yPos += keyHeight + spacing;
+        default:
+        {
+            const int steps = qskFocusChainIncrement( event );
+
+            if ( steps != 0 )
+            {
+                const int nextIndex = nextKeyIndex( index, steps > 0 );
+                if ( nextIndex >= 0 )
+                {
+                    setFocusedKeyIndex( nextIndex );
+                    return;
+                }
+            }
+        }
     }
+
+    Inherited::keyPressEvent( event );
 }
 
-bool QskVirtualKeyboard::hasKey( int keyCode ) const
+void QskVirtualKeyboard::keyReleaseEvent( QKeyEvent* event )
 {
-    return m_data->keyCodes.contains( keyCode );
+    switch ( event->key() )
+    {
+        case Qt::Key_Select:
+        case Qt::Key_Space:
+        case Qt::Key_Enter:
+        case Qt::Key_Return:
+        {
+            if ( !event->isAutoRepeat() )
+                setPressedKeyIndex( -1 );
+
+            return;
+        }
+    }
+
+    Inherited::keyReleaseEvent( event );
+}
+
+void QskVirtualKeyboard::focusInEvent( QFocusEvent* event )
+{
+    int index = m_data->focusedIndex;
+
+    switch ( event->reason() )
+    {
+        case Qt::TabFocusReason:
+        {
+            index = nextKeyIndex( -1, true );
+            break;
+        }
+
+        case Qt::BacktabFocusReason:
+        {
+            index = nextKeyIndex( RowCount * ColumnCount, false );
+            break;
+        }
+
+        default:
+        {
+            if ( index < 0 )
+                index = nextKeyIndex( -1, true );
+        }
+    }
+
+    setFocusedKeyIndex( index );
+
+    Inherited::focusInEvent( event );
 }
 
-void QskVirtualKeyboard::buttonPressed()
+void QskVirtualKeyboard::timerEvent( QTimerEvent* event )
 {
-    const auto button = static_cast< const Button* >( sender() );
-    if ( button == nullptr )
+    if ( event->timerId() == m_data->repeatTimer.timerId() )
+    {
+        const auto index = m_data->pressedIndex;
+
+        if ( index >= 0 )
+        {
+            triggerKey( keyCodeAt( index / ColumnCount, index % ColumnCount ) );
+            m_data->repeatTimer.start( m_data->autoRepeatInterval, this );
+        }
+        else
+        {
+            m_data->repeatTimer.stop();
+        }
+
         return;
+    }
 
-    const auto& keyCodes = ( *m_data->currentLayout )[ m_data->mode ];
-    const int key = keyCodes.data[ button->row() ][ button->column() ];
+    Inherited::timerEvent( event );
+}
 
+void QskVirtualKeyboard::triggerKey( int key )
+{
     // Mode-switching keys
     switch ( key )
     {
@@ -558,14 +762,32 @@ void QskVirtualKeyboard::updateLocale( const QLocale& locale )
         m_data->keyCodes = qskKeyCodes( *newLayout );
 
         setMode( LowercaseMode );
-        polish();
+        update();
     }
 }
 
 void QskVirtualKeyboard::setMode( QskVirtualKeyboard::Mode mode )
 {
     m_data->mode = mode;
-    polish();
+    update();
+
+    const int index = m_data->focusedIndex;
+    if ( index >= 0 )
+    {
+        if ( keyCodeAt( index / ColumnCount, index % ColumnCount ) == 0 )
+        {
+            // the focused key does not exist in the new mode
+
+            int nextIndex = nextKeyIndex( index, false );
+            if ( nextIndex < 0 )
+                nextIndex = nextKeyIndex( index, true );
+
+            setFocusedKeyIndex( nextIndex );
+        }
+
+        // the geometry of the keys might have changed
+        Q_EMIT focusIndicatorRectChanged();
+    }
 
     Q_EMIT modeChanged( m_data->mode );
 }
@@ -37,6 +37,25 @@ class QSK_EXPORT QskVirtualKeyboard : public QskBox
 
     bool hasKey( int keyCode ) const;
 
+    /*
+        The keys are not items, but drawn by the skinlet.
+        A key is identified by its index: row * columnCount() + column
+     */
+    int rowCount() const;
+    int columnCount() const;
+
+    // 0, when there is no key at this position in the current mode
+    int keyCodeAt( int row, int column ) const;
+    QString textForKey( int keyCode ) const;
+
+    int keyIndexAt( const QPointF& ) const;
+    int pressedKeyIndex() const;
+
+    // the key, that can be triggered by Qt::Key_Select/Qt::Key_Space
+    int focusedKeyIndex() const;
+
+    QRectF focusIndicatorRect() const override;
+
   Q_SIGNALS:
     void modeChanged( Mode );
     void keySelected( int keyCode );
@@ -48,8 +67,28 @@ class QSK_EXPORT QskVirtualKeyboard : public QskBox
     QskAspect::Subcontrol substitutedSubcontrol(
         QskAspect::Subcontrol ) const override;
 
+    void mousePressEvent( QMouseEvent* ) override;
+    void mouseMoveEvent( QMouseEvent* ) override;
+    void mouseReleaseEvent( QMouseEvent* ) override;
+    void mouseUngrabEvent() override;
+
+    void keyPressEvent( QKeyEvent* ) override;
+    void keyReleaseEvent( QKeyEvent* ) override;
+
+    void focusInEvent( QFocusEvent* ) override;
+
+    void timerEvent( QTimerEvent* ) override;
+
   private:
-    void buttonPressed();
+    void setPressedKeyIndex( int );
+    void setFocusedKeyIndex( int );
+
+    QskAspect::States keyStates( int index ) const;
+    void startKeyTransition( int index, QskAspect::States oldStates );
+
+    int nextKeyIndex( int index, bool forwards ) const;
+    int nextRowKeyIndex( int index, bool forwards ) const;
+    void triggerKey( int keyCode );
 
     class PrivateData;
     std::unique_ptr< PrivateData > m_data;
@@ -0,0 +1,283 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskVirtualKeyboardSkinlet.h"
+#include "QskVirtualKeyboard.h"
+#include "QskPushButton.h"
+#include "QskFunctions.h"
+
+static qreal qskKeyStretch( int key )
+{
+    switch ( key )
+    {
+        case Qt::Key_Backspace:
+        case Qt::Key_Shift:
+        case Qt::Key_CapsLock:
+            return 1.5;
+
+        case Qt::Key_Space:
+            return 3.5;
+
+        case Qt::Key_Return:
+        case Qt::Key_Mode_switch:
+
+        // Possibly smaller
+        default:
+            break;
+    }
+
+    return 1.0;
+}
+
+static qreal qskBaseKeyWidth( const QskVirtualKeyboard* keyboard,
+    int row, qreal width, qreal spacing )
+{
+    qreal stretch = 0.0;
+    qreal totalSpacing = -spacing;
+
+    for ( int col = 0; col < keyboard->columnCount(); col++ )
+    {
+        if ( const int key = keyboard->keyCodeAt( row, col ) )
+        {
+            stretch += qskKeyStretch( key );
+            totalSpacing += spacing;
+        }
+    }
+
+    if ( stretch == 0.0 )
+        stretch = keyboard->columnCount();
+
+    return ( width - totalSpacing ) / stretch;
+}
+
+static inline qreal qskKeyHeight(
+    const QskVirtualKeyboard* keyboard, qreal height, qreal spacing )
+{
+    const auto rowCount = keyboard->rowCount();
+    return ( height - ( rowCount - 1 ) * spacing ) / rowCount;
+}
+
+static inline bool qskIsKeySubcontrol( QskAspect::Subcontrol subControl )
+{
+    return ( subControl == QskVirtualKeyboard::ButtonPanel )
+        || ( subControl == QskVirtualKeyboard::ButtonText );
+}
+
+QskVirtualKeyboardSkinlet::QskVirtualKeyboardSkinlet( QskSkin* skin )
+    : Inherited( skin )
+{
+    setNodeRoles( { PanelRole, ButtonPanelRole, ButtonTextRole } );
+}
+
+QskVirtualKeyboardSkinlet::~QskVirtualKeyboardSkinlet() = default;
+
+QRectF QskVirtualKeyboardSkinlet::subControlRect( const QskSkinnable* skinnable,
+    const QRectF& contentsRect, QskAspect::Subcontrol subControl ) const
+{
+    if ( subControl == QskVirtualKeyboard::Panel )
+        return contentsRect;
+
+    return Inherited::subControlRect( skinnable, contentsRect, subControl );
+}
+
+QSGNode* QskVirtualKeyboardSkinlet::updateSubNode(
+    const QskSkinnable* skinnable, quint8 nodeRole, QSGNode* node ) const
+{
+    using Q = QskVirtualKeyboard;
+
+    switch ( nodeRole )
+    {
+        case PanelRole:
+            return Inherited::updateSubNode( skinnable, Inherited::PanelRole, node );
+
+        case ButtonPanelRole:
+            return updateSeriesNode( skinnable, Q::ButtonPanel, node );
+
+        case ButtonTextRole:
+            return updateSeriesNode( skinnable, Q::ButtonText, node );
+    }
+
+    return nullptr;
+}
+
+int QskVirtualKeyboardSkinlet::sampleCount(
+    const QskSkinnable* skinnable, QskAspect::Subcontrol subControl ) const
+{
+    if ( qskIsKeySubcontrol( subControl ) )
+    {
+        const auto keyboard = static_cast< const QskVirtualKeyboard* >( skinnable );
+        return keyboard->rowCount() * keyboard->columnCount();
+    }
+
+    return Inherited::sampleCount( skinnable, subControl );
+}
+
+QRectF QskVirtualKeyboardSkinlet::sampleRect( const QskSkinnable* skinnable,
+    const QRectF& contentsRect, QskAspect::Subcontrol subControl, int index ) const
+{
+    using Q = QskVirtualKeyboard;
+
+    if ( qskIsKeySubcontrol( subControl ) )
+    {
+        const auto keyboard = static_cast< const QskVirtualKeyboard* >( skinnable );
+
+        const auto columnCount = keyboard->columnCount();
+        const auto rect = keyRect( keyboard, contentsRect,
+            index / columnCount, index % columnCount );
+
+        if ( subControl == Q::ButtonText && !rect.isEmpty() )
+            return skinnable->innerBox( Q::ButtonPanel, rect );
+
+        return rect;
+    }
+
+    return Inherited::sampleRect( skinnable, contentsRect, subControl, index );
+}
+
+int QskVirtualKeyboardSkinlet::sampleIndexAt( const QskSkinnable* skinnable,
+    const QRectF& contentsRect, QskAspect::Subcontrol subControl,
+    const QPointF& pos ) const
+{
+    using Q = QskVirtualKeyboard;
+
+    if ( !qskIsKeySubcontrol( subControl ) )
+        return Inherited::sampleIndexAt( skinnable, contentsRect, subControl, pos );
+
+    /*
+        All keys of a row have the same height and are laid out from
+        left to right, so we can find the key without calculating
+        the rectangles of all keys.
+     */
+
+    const auto keyboard = static_cast< const QskVirtualKeyboard* >( skinnable );
+
+    const auto area = skinnable->innerBox( Q::Panel,
+        subControlRect( skinnable, contentsRect, Q::Panel ) );
+
+    if ( !area.contains( pos ) )
+        return -1;
+
+    const auto spacing = skinnable->spacingHint( Q::Panel );
+
+    const auto keyHeight = qskKeyHeight( keyboard, area.height(), spacing );
+    if ( keyHeight <= 0.0 )
+        return -1;
+
+    const auto dy = pos.y() - area.top();
+
+    const int row = static_cast< int >( dy / ( keyHeight + spacing ) );
+    if ( row >= keyboard->rowCount() || dy - row * ( keyHeight + spacing ) > keyHeight )
+        return -1;
+
+    const auto baseKeyWidth = qskBaseKeyWidth( keyboard, row, area.width(), spacing );
+
+    qreal x = area.left();
+
+    for ( int col = 0; col < keyboard->columnCount(); col++ )
+    {
+        const int key = keyboard->keyCodeAt( row, col );
+        if ( key == 0 )
+            continue;
+
+        if ( pos.x() < x )
+            break; // between 2 keys
+
+        const auto keyWidth = baseKeyWidth * qskKeyStretch( key );
+        if ( pos.x() <= x + keyWidth )
+            return row * keyboard->columnCount() + col;
+
+        x += keyWidth + spacing;
+    }
+
+    return -1;
+}
+
+QskAspect::States QskVirtualKeyboardSkinlet::sampleStates(
+    const QskSkinnable* skinnable, QskAspect::Subcontrol subControl, int index ) const
+{
+    auto states = Inherited::sampleStates( skinnable, subControl, index );
+
+    if ( qskIsKeySubcontrol( subControl ) )
+    {
+        const auto keyboard = static_cast< const QskVirtualKeyboard* >( skinnable );
+
+        if ( keyboard->pressedKeyIndex() == index )
+            states |= QskPushButton::Pressed;
+
+        // only the key, that can be triggered by the keyboard, is focused
+        if ( keyboard->focusedKeyIndex() != index )
+            states &= ~QskControl::Focused;
+    }
+
+    return states;
+}
+
+QSGNode* QskVirtualKeyboardSkinlet::updateSampleNode( const QskSkinnable* skinnable,
+    QskAspect::Subcontrol subControl, int index, QSGNode* node ) const
+{
+    using Q = QskVirtualKeyboard;
+
+    const auto keyboard = static_cast< const QskVirtualKeyboard* >( skinnable );
+
+    const auto rect = sampleRect( skinnable,
+        keyboard->contentsRect(), subControl, index );
+
+    if ( rect.isEmpty() )
+        return nullptr;
+
+    if ( subControl == Q::ButtonPanel )
+        return updateBoxNode( skinnable, node, rect, subControl );
+
+    if ( subControl == Q::ButtonText )
+    {
+        const auto columnCount = keyboard->columnCount();
+        const auto key = keyboard->keyCodeAt( index / columnCount, index % columnCount );
+
+        const auto alignment = skinnable->alignmentHint( subControl, Qt::AlignCenter );
+
+        return updateTextNode( skinnable, node, rect,
+            alignment, keyboard->textForKey( key ), subControl );
+    }
+
+    return Inherited::updateSampleNode( skinnable, subControl, index, node );
+}
+
+QRectF QskVirtualKeyboardSkinlet::keyRect( const QskVirtualKeyboard* keyboard,
+    const QRectF& contentsRect, int row, int column ) const
+{
+    using Q = QskVirtualKeyboard;
+
+    const int key = keyboard->keyCodeAt( row, column );
+    if ( key == 0 )
+        return QRectF();
+
+    const auto area = keyboard->innerBox( Q::Panel,
+        subControlRect( keyboard, contentsRect, Q::Panel ) );
+
+    if ( area.isEmpty() )
+        return QRectF();
+
+    const auto spacing = keyboard->spacingHint( Q::Panel );
+
+    const auto keyHeight = qskKeyHeight( keyboard, area.height(), spacing );
+    const auto baseKeyWidth = qskBaseKeyWidth( keyboard, row, area.width(), spacing );
+
+    qreal x = area.left();
+
+    for ( int col = 0; col < column; col++ )
+    {
+        if ( const int k = keyboard->keyCodeAt( row, col ) )
+            x += baseKeyWidth * qskKeyStretch( k ) + spacing;
+    }
+
+    const qreal y = area.top() + row * ( keyHeight + spacing );
+
+    const QRectF rect( x, y, baseKeyWidth * qskKeyStretch( key ), keyHeight );
+
+    // the margins of a key shrink its panel, but not its area for hit testing
+    return qskValidOrEmptyInnerRect( rect, keyboard->marginHint( Q::ButtonPanel ) );
+}
+
+#include "moc_QskVirtualKeyboardSkinlet.cpp"
@@ -0,0 +1,62 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_VIRTUAL_KEYBOARD_SKINLET_H
+#define QSK_VIRTUAL_KEYBOARD_SKINLET_H
+
+#include "QskBoxSkinlet.h"
+
+class QskVirtualKeyboard;
+
+/*
+    All keys are samples of QskVirtualKeyboard::ButtonPanel/ButtonText,
+    where the index of a key is row * columnCount() + column.
+ */
+class QSK_EXPORT QskVirtualKeyboardSkinlet : public QskBoxSkinlet
+{
+    Q_GADGET
+
+    using Inherited = QskBoxSkinlet;
+
+  public:
+    enum NodeRole
+    {
+        PanelRole,
+        ButtonPanelRole,
+        ButtonTextRole,
+
+        RoleCount
+    };
+
+    Q_INVOKABLE QskVirtualKeyboardSkinlet( QskSkin* = nullptr );
+    ~QskVirtualKeyboardSkinlet() override;
+
+    QRectF subControlRect( const QskSkinnable*,
+        const QRectF&, QskAspect::Subcontrol ) const override;
+
+    int sampleCount( const QskSkinnable*, QskAspect::Subcontrol ) const override;
+
+    QRectF sampleRect( const QskSkinnable*,
+        const QRectF&, QskAspect::Subcontrol, int index ) const override;
+
+    int sampleIndexAt( const QskSkinnable*, const QRectF&,
+        QskAspect::Subcontrol, const QPointF& ) const override;
+
+    QskAspect::States sampleStates( const QskSkinnable*,
+        QskAspect::Subcontrol, int index ) const override;
+
+  protected:
+    QSGNode* updateSubNode( const QskSkinnable*,
+        quint8 nodeRole, QSGNode* ) const override;
+
+    QSGNode* updateSampleNode( const QskSkinnable*,
+        QskAspect::Subcontrol, int index, QSGNode* ) const override;
+
+  private:
+    QRectF keyRect( const QskVirtualKeyboard*,
+        const QRectF&, int row, int column ) const;
+};
+
+#endif
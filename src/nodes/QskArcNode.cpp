@@ -7,49 +7,75 @@
 #include "QskArcMetrics.h"
 #include "QskArcRenderer.h"
 #include "QskGradient.h"
+#include "QskSGNode.h"
 
-namespace
+#include <qsgvertexcolormaterial.h>
+
+QSK_QT_PRIVATE_BEGIN
+#include <private/qsgnode_p.h>
+QSK_QT_PRIVATE_END
+
+Q_GLOBAL_STATIC( QSGVertexColorMaterial, qskMaterialColorVertex )
+
+static inline QskHashValue qskArcHash( const QRectF& rect,
+    const QskArcMetrics& metrics, const QskGradient& gradient )
 {
-    class ArcData
-    {
-      public:
-        const QskArcMetrics& metrics;
-        const QskGradient& gradient;
-    };
+    QskHashValue hash = 14000;
+
+    const qreal values[] = { rect.x(), rect.y(), rect.width(), rect.height() };
+    hash = qHashBits( values, sizeof( values ), hash );
+
+    hash = metrics.hash( hash );
+    return gradient.hash( hash );
 }
 
+class QskArcNodePrivate final : public QSGGeometryNodePrivate
+{
+  public:
+    QskArcNodePrivate()
+        : geometry( QSGGeometry::defaultAttributes_ColoredPoint2D(), 0 )
+    {
+        geometry.setDrawingMode( QSGGeometry::DrawTriangleStrip );
+    }
+
+    QSGGeometry geometry;
+    QskHashValue hash = 0;
+};
+
 QskArcNode::QskArcNode()
+    : QSGGeometryNode( *new QskArcNodePrivate )
 {
+    Q_D( QskArcNode );
+
+    setMaterial( qskMaterialColorVertex );
+    setGeometry( &d->geometry );
 }
 
 QskArcNode::~QskArcNode()
 {
 }
 
-void QskArcNode::setArcData( const QRectF& rect, const QskArcMetrics& metrics,
-    const QskGradient& gradient, QQuickWindow* window )
+void QskArcNode::setArcData( const QRectF& rect,
+    const QskArcMetrics& metrics, const QskGradient& gradient )
 {
-    const ArcData arcData { metrics, gradient };
-    update( window, rect, QSizeF(), &arcData );
-}
+    Q_D( QskArcNode );
 
-void QskArcNode::paint( QPainter* painter, const QSize& size, const void* nodeData )
-{
-    const auto arcData = reinterpret_cast< const ArcData* >( nodeData );
+    if ( rect.isEmpty() || metrics.isNull() || !gradient.isVisible() )
+    {
+        d->hash = 0;
+        QskSGNode::resetGeometry( this );
 
-    const qreal w = arcData->metrics.width();
-    const QRectF rect( 0.5 * w, 0.5 * w, size.width() - w, size.height() - w );
+        return;
+    }
 
-    QskArcRenderer renderer;
-    renderer.renderArc( rect, arcData->metrics, arcData->gradient, painter );
-}
+    const auto hash = qskArcHash( rect, metrics, gradient );
+    if ( hash == d->hash )
+        return;
 
-QskHashValue QskArcNode::hash( const void* nodeData ) const
-{
-    const auto arcData = reinterpret_cast< const ArcData* >( nodeData );
+    d->hash = hash;
 
-    auto h = arcData->metrics.hash();
-    return arcData->gradient.hash( h );
+    QskArcRenderer renderer;
+    renderer.renderArc( rect, metrics, gradient, d->geometry );
 
-    return h;
+    markDirty( QSGNode::DirtyGeometry );
 }
@@ -6,25 +6,30 @@
 #ifndef QSK_ARC_NODE_H
 #define QSK_ARC_NODE_H
 
-#include "QskPaintedNode.h"
+#include "QskGlobal.h"
+#include <qsgnode.h>
 
 class QskArcMetrics;
 class QskGradient;
 
-// should be a QSGGeometryNode, TODO ..
+class QskArcNodePrivate;
 
-class QSK_EXPORT QskArcNode : public QskPaintedNode
+/*
+    The arc is tessellated into a triangle strip with colored vertices.
+    Changing the angles - f.e. when animating a progress ring - only
+    results in an update of the vertices, while all arcs can be batched
+    as they share the same material.
+ */
+class QSK_EXPORT QskArcNode : public QSGGeometryNode
 {
   public:
     QskArcNode();
     ~QskArcNode() override;
 
-    void setArcData( const QRectF&, const QskArcMetrics&,
-        const QskGradient&, QQuickWindow* );
+    void setArcData( const QRectF&, const QskArcMetrics&, const QskGradient& );
 
-  protected:
-    void paint( QPainter*, const QSize&, const void* nodeData ) override;
-    QskHashValue hash( const void* nodeData ) const override;
+  private:
+    Q_DECLARE_PRIVATE( QskArcNode )
 };
 
 #endif
@@ -8,8 +8,13 @@
 #include "QskGradient.h"
 #include "QskGradientDirection.h"
 
+#include "QskVertex.h"
+
 #include <qpainter.h>
 #include <qrect.h>
+#include <qsggeometry.h>
+
+#include <algorithm>
 
 void QskArcRenderer::renderArc(const QRectF& rect,
     const QskArcMetrics& metrics, const QskGradient& gradient, QPainter* painter )
@@ -52,3 +57,255 @@ void QskArcRenderer::renderArc(const QRectF& rect,
 
     painter->drawArc( rect, startAngle, spanAngle );
 }
+
+namespace
+{
+    class Ring
+    {
+      public:
+        qreal offset; // from the centerline
+        qreal alpha;
+        QskVertex::Color color;
+    };
+
+    class Angle
+    {
+      public:
+        qreal value; // from the start angle in direction of the arc
+        QskVertex::Color color;
+    };
+
+    class Ellipse
+    {
+      public:
+        inline QPointF pointAt( qreal radians, qreal offset ) const
+        {
+            const qreal a = qMax( rx + offset, 0.0 );
+            const qreal b = qMax( ry + offset, 0.0 );
+
+            return QPointF( cx + a * qCos( radians ), cy - b * qSin( radians ) );
+        }
+
+        qreal cx, cy, rx, ry;
+    };
+}
+
+static QskVertex::Color qskColorAt( const QskGradientStops& stops, qreal pos )
+{
+    if ( stops.isEmpty() )
+        return QskVertex::Color();
+
+    if ( pos <= stops.first().position() )
+        return stops.first().rgb();
+
+    for ( int i = 1; i < stops.count(); i++ )
+    {
+        if ( pos <= stops[i].position() )
+            return QskGradientStop::interpolated( stops[i - 1], stops[i], pos );
+    }
+
+    return stops.last().rgb();
+}
+
+static inline QskVertex::Color qskFaded( QskVertex::Color color, qreal alpha )
+{
+    if ( alpha >= 1.0 )
+        return color;
+
+    // premultiplied
+    return QskVertex::Color( color.r * alpha, color.g * alpha,
+        color.b * alpha, color.a * alpha );
+}
+
+static QVector< Ring > qskRings( const QskArcMetrics& metrics,
+    const QRectF& rect, const QskGradientStops& stops, bool isRadial )
+{
+    /*
+        The offsets from the centerline, where the vertices are located.
+        For antialiasing we have a fringe of 1 pixel fading out
+        to transparent at the inner and outer border.
+     */
+    const qreal hw = 0.5 * metrics.width();
+    const qreal aa = ( hw > 0.5 ) ? 0.5 : 0.0;
+
+    QVector< Ring > rings;
+    rings.reserve( 4 + stops.count() );
+
+    if ( aa > 0.0 )
+        rings += { -hw - aa, 0.0, QskVertex::Color() };
+
+    rings += { -hw + aa, 1.0, QskVertex::Color() };
+
+    if ( isRadial )
+    {
+        // like QRadialGradient( center, qMin( width, height ) )
+        const qreal radius = qMin( rect.width(), rect.height() );
+        const qreal rmin = 0.5 * radius;
+
+        for ( const auto& stop : stops )
+        {
+            const qreal offset = stop.position() * radius - rmin;
+            if ( offset > -hw + aa && offset < hw - aa )
+                rings += { offset, 1.0, stop.rgb() };
+        }
+
+        rings += { hw - aa, 1.0, QskVertex::Color() };
+
+        if ( aa > 0.0 )
+            rings += { hw + aa, 0.0, QskVertex::Color() };
+
+        for ( auto& ring : rings )
+        {
+            if ( ring.offset <= -hw + aa || ring.offset >= hw - aa )
+                ring.color = qskColorAt( stops, ( rmin + ring.offset ) / radius );
+        }
+    }
+    else
+    {
+        rings += { hw - aa, 1.0, QskVertex::Color() };
+
+        if ( aa > 0.0 )
+            rings += { hw + aa, 0.0, QskVertex::Color() };
+    }
+
+    return rings;
+}
+
+static QVector< Angle > qskAngles( const QskArcMetrics& metrics,
+    qreal radius, const QskGradientStops& stops, bool isConic )
+{
+    /*
+        The tessellation of the arc with a chord error below 1/4 pixel,
+        and for conic gradients the positions of the stops.
+     */
+    const qreal spanAngle = qBound( -360.0, metrics.spanAngle(), 360.0 );
+    const qreal span = qAbs( spanAngle );
+
+    const qreal step = qRadiansToDegrees(
+        2.0 * qAcos( 1.0 - 0.25 / qMax( radius, 0.25 ) ) );
+
+    const int count = qBound( 1, qCeil( span / step ), 2000 );
+
+    QVector< Angle > angles;
+    angles.reserve( count + 1 + stops.count() );
+
+    if ( !isConic )
+    {
+        for ( int i = 0; i <= count; i++ )
+            angles += { i * span / count, QskVertex::Color() };
+
+        return angles;
+    }
+
+    /*
+        Like QConicalGradient( center, startAngle ): the stops are distributed
+        counter-clockwise over 360°. Clockwise arcs run from the end
+        of the gradient backwards.
+     */
+    const bool clockwise = spanAngle < 0.0;
+
+    QVector< Angle > stopAngles;
+    for ( const auto& stop : stops )
+    {
+        const qreal pos = clockwise ? 1.0 - stop.position() : stop.position();
+        const qreal value = pos * 360.0;
+
+        if ( value > 0.0 && value < span )
+            stopAngles += { value, stop.rgb() };
+    }
+
+    if ( clockwise )
+        std::reverse( stopAngles.begin(), stopAngles.end() );
+
+    int j = 0;
+    for ( int i = 0; i <= count; i++ )
+    {
+        const qreal value = i * span / count;
+
+        while ( j < stopAngles.count() && stopAngles[j].value <= value )
+            angles += stopAngles[j++];
+
+        const qreal pos = value / 360.0;
+        angles += { value, qskColorAt( stops, clockwise ? 1.0 - pos : pos ) };
+    }
+
+    return angles;
+}
+
+void QskArcRenderer::renderArc( const QRectF& rect,
+    const QskArcMetrics& metrics, const QskGradient& gradient, QSGGeometry& geometry )
+{
+    using namespace QskVertex;
+
+    const qreal hw = 0.5 * metrics.width();
+    const qreal spanAngle = qBound( -360.0, metrics.spanAngle(), 360.0 );
+
+    if ( hw <= 0.0 || qFuzzyIsNull( spanAngle ) || !gradient.isVisible() )
+    {
+        geometry.allocate( 0 );
+        return;
+    }
+
+    // the centerline of the arc, like the pen when painting
+    const auto r = rect.adjusted( hw, hw, -hw, -hw );
+
+    const Ellipse ellipse { r.center().x(), r.center().y(),
+        qMax( 0.5 * r.width(), 0.0 ), qMax( 0.5 * r.height(), 0.0 ) };
+
+    const bool isMonochrome = gradient.isMonochrome();
+
+    bool isRadial = false;
+    if ( !isMonochrome && gradient.type() == QskGradient::Linear )
+        isRadial = gradient.linearDirection().isVertical();
+
+    const auto stops = gradient.stops();
+
+    auto rings = qskRings( metrics, r, stops, isRadial );
+    auto angles = qskAngles( metrics, qMax( ellipse.rx, ellipse.ry ) + hw,
+        stops, !( isRadial || isMonochrome ) );
+
+    if ( isMonochrome )
+    {
+        const Color color( gradient.rgbStart() );
+        for ( auto& angle : angles )
+            angle.color = color;
+    }
+
+    /*
+        One strip for each band between 2 rings. Running back and forth
+        the bands can be connected without any extra vertices, as the
+        turning triangles are degenerated.
+     */
+    const int bandCount = rings.count() - 1;
+    auto lines = allocateLines< ColoredLine >( geometry, bandCount * angles.count() );
+
+    const qreal startAngle = metrics.startAngle();
+    const qreal direction = ( spanAngle < 0.0 ) ? -1.0 : 1.0;
+
+    for ( int i = 0; i < bandCount; i++ )
+    {
+        const bool forward = ( i % 2 ) == 0;
+
+        const auto& ring1 = forward ? rings[i] : rings[i + 1];
+        const auto& ring2 = forward ? rings[i + 1] : rings[i];
+
+        for ( int j = 0; j < angles.count(); j++ )
+        {
+            const auto& angle = angles[ forward ? j : angles.count() - 1 - j ];
+
+            const qreal radians = qDegreesToRadians(
+                startAngle + direction * angle.value );
+
+            const auto p1 = ellipse.pointAt( radians, ring1.offset );
+            const auto p2 = ellipse.pointAt( radians, ring2.offset );
+
+            const auto c1 = isRadial ? ring1.color : angle.color;
+            const auto c2 = isRadial ? ring2.color : angle.color;
+
+            lines->setLine( p1.x(), p1.y(), qskFaded( c1, ring1.alpha ),
+                p2.x(), p2.y(), qskFaded( c2, ring2.alpha ) );
+
+            lines++;
+        }
+    }
+}
@@ -13,12 +13,24 @@ class QskGradient;
 
 class QPainter;
 class QRectF;
+class QSGGeometry;
 
 class QSK_EXPORT QskArcRenderer
 {
   public:
     void renderArc( const QRectF&, const QskArcMetrics&,
         const QskGradient&, QPainter* );
+
+    /*
+        Filling the geometry with a triangle strip including the color
+        information: see QSGGeometry::defaultAttributes_ColoredPoint2D()
+
+        The gradient is interpreted the same way as when painting:
+        a vertical linear gradient runs from the center to the outside,
+        anything else is conic, starting at the start angle of the arc.
+     */
+    void renderArc( const QRectF&, const QskArcMetrics&,
+        const QskGradient&, QSGGeometry& );
 };
 
 #endif
@@ -12,6 +12,10 @@ QSK_QT_PRIVATE_BEGIN
 QSK_QT_PRIVATE_END
 
 #include <qcoreapplication.h>
+#include <qmutex.h>
+#include <qvarlengtharray.h>
+
+#include <list>
 
 namespace
 {
@@ -58,40 +62,89 @@ namespace
       public:
         inline bool operator==( const HashKey& other ) const
         {
-            return rhi == other.rhi && spreadMode == other.spreadMode && stops == other.stops;
+            return hash == other.hash && spreadMode == other.spreadMode
+                && stops == other.stops;
         }
 
-        const void* rhi;
-        const QskGradientStops stops;
-        const QskGradient::SpreadMode spreadMode;
+        QskHashValue hash;
+        QskGradientStops stops;
+        QskGradient::SpreadMode spreadMode;
     };
 
     inline size_t qHash( const HashKey& key, size_t seed = 0 )
     {
-        size_t values = seed + key.spreadMode;
+        return key.hash ^ seed;
+    }
 
-        for ( const auto& stop : key.stops )
-            values += stop.rgb();
+    inline QskHashValue qskRampHash(
+        const QskGradientStops& stops, QskGradient::SpreadMode spreadMode )
+    {
+        // positions and colors
+        auto hash = ::qHash( static_cast< int >( spreadMode ), 47111 );
 
-        return values;
+        for ( const auto& stop : stops )
+            hash = stop.hash( hash );
+
+        return hash;
+    }
+}
+
+class QskColorRamp::Ramp
+{
+  public:
+    Ramp( const HashKey& key )
+        : key( key )
+    {
     }
 
+    const HashKey key;
+
+    int refCount = 0;
+
+    // position in the list of unused ramps
+    std::list< Ramp* >::iterator unusedPos;
+
+    // usually we have only one rhi
+    QVarLengthArray< QPair< const void*, Texture* >, 1 > textures;
+};
+
+namespace
+{
+    using Ramp = QskColorRamp::Ramp;
+
     class Cache
     {
       public:
-        ~Cache() { qDeleteAll( m_hashTable ); }
+        ~Cache();
 
         void cleanupRhi( const QRhi* );
 
-        Texture* texture( const void* rhi,
-            const QskGradientStops&, QskGradient::SpreadMode );
+        Ramp* acquireRamp( const QskGradientStops&, QskGradient::SpreadMode );
+        void releaseRamp( Ramp* );
+
+        Texture* texture( const void* rhi, Ramp* );
+
+        QMutex mutex;
+
+        qint64 maxBytes = 4 * 1024 * 1024;
+        QskColorRamp::Statistics statistics;
 
       private:
-        QHash< HashKey, Texture* > m_hashTable;
+        void evict( const void* rhi );
+        void removeRamp( Ramp* );
+
+        QHash< HashKey, Ramp* > m_hashTable;
+
+        // the least recently used ramp is at the end
+        std::list< Ramp* > m_unusedRamps;
+
         QVector< const QRhi* > m_rhiTable; // no QSet: we usually have only one entry
     };
 
     static Cache* s_cache;
+
+    // 256 colors with 4 bytes
+    const qint64 textureBytes = 256 * 4;
 }
 
 static void qskCleanupCache()
@@ -106,40 +159,189 @@ static void qskCleanupRhi( const QRhi* rhi )
         s_cache->cleanupRhi( rhi );
 }
 
-Texture* Cache::texture( const void* rhi,
+static Cache* qskCache()
+{
+    if ( s_cache == nullptr )
+    {
+        s_cache = new Cache();
+
+        /*
+            For RHI we have QRhi::addCleanupCallback, but with
+            OpenGL we would have to fiddle around with QOpenGLSharedResource
+            But as the OpenGL path is only for Qt5 we do not want to spend
+            much energy on finetuning the resource management.
+         */
+        qAddPostRoutine( qskCleanupCache );
+    }
+
+    return s_cache;
+}
+
+Cache::~Cache()
+{
+    for ( auto ramp : qAsConst( m_hashTable ) )
+    {
+        for ( const auto& entry : ramp->textures )
+            delete entry.second;
+
+        delete ramp;
+    }
+}
+
+Ramp* Cache::acquireRamp(
     const QskGradientStops& stops, QskGradient::SpreadMode spreadMode )
 {
-    const HashKey key { rhi, stops, spreadMode };
+    const HashKey key { qskRampHash( stops, spreadMode ), stops, spreadMode };
+
+    auto& ramp = m_hashTable[ key ];
+    if ( ramp == nullptr )
+    {
+        ramp = new Ramp( key );
+        statistics.rampCount++;
+    }
+    else if ( ramp->refCount == 0 )
+    {
+        m_unusedRamps.erase( ramp->unusedPos );
+        statistics.unusedCount--;
+    }
+
+    ramp->refCount++;
+
+    return ramp;
+}
+
+void Cache::releaseRamp( Ramp* ramp )
+{
+    if ( --ramp->refCount > 0 )
+        return;
 
-    auto texture = m_hashTable[key];
-    if ( texture == nullptr )
+    if ( ramp->textures.isEmpty() )
     {
-        texture = new Texture( stops, spreadMode );
-        m_hashTable[ key ] = texture;
+        // nothing worth to be cached
+        removeRamp( ramp );
+    }
+    else
+    {
+        m_unusedRamps.push_front( ramp );
+        ramp->unusedPos = m_unusedRamps.begin();
+
+        statistics.unusedCount++;
+    }
+}
 
-        if ( rhi != nullptr )
+Texture* Cache::texture( const void* rhi, Ramp* ramp )
+{
+    for ( const auto& entry : qAsConst( ramp->textures ) )
+    {
+        if ( entry.first == rhi )
         {
-            auto myrhi = ( QRhi* )rhi;
+            statistics.hits++;
+            return entry.second;
+        }
+    }
 
-            if ( !m_rhiTable.contains( myrhi ) )
+    statistics.misses++;
+
+    auto texture = new Texture( ramp->key.stops, ramp->key.spreadMode );
+    ramp->textures += qMakePair( rhi, texture );
+
+    statistics.textureCount++;
+    statistics.bytes += textureBytes;
+
+    if ( rhi != nullptr )
+    {
+        auto myrhi = ( QRhi* )rhi;
+
+        if ( !m_rhiTable.contains( myrhi ) )
+        {
+            myrhi->addCleanupCallback( qskCleanupRhi );
+            m_rhiTable += myrhi;
+        }
+    }
+
+    evict( rhi );
+
+    return texture;
+}
+
+void Cache::evict( const void* rhi )
+{
+    /*
+        Textures have to be deleted in the thread of their rhi,
+        so we only evict textures of the rhi, that is in use.
+     */
+
+    auto it = m_unusedRamps.end();
+    while ( ( statistics.bytes > maxBytes ) && ( it != m_unusedRamps.begin() ) )
+    {
+        auto ramp = *( --it );
+
+        auto& textures = ramp->textures;
+
+        for ( int i = 0; i < textures.size(); i++ )
+        {
+            if ( textures[i].first == rhi )
             {
-                myrhi->addCleanupCallback( qskCleanupRhi );
-                m_rhiTable += myrhi;
+                delete textures[i].second;
+                textures.remove( i );
+
+                statistics.textureCount--;
+                statistics.bytes -= textureBytes;
+                statistics.evictions++;
+
+                break;
             }
         }
+
+        if ( textures.isEmpty() )
+        {
+            it = m_unusedRamps.erase( it );
+            statistics.unusedCount--;
+
+            removeRamp( ramp );
+        }
     }
+}
 
-    return texture;
+void Cache::removeRamp( Ramp* ramp )
+{
+    m_hashTable.remove( ramp->key );
+    statistics.rampCount--;
+
+    delete ramp;
 }
 
 void Cache::cleanupRhi( const QRhi* rhi )
 {
-    for ( auto it = m_hashTable.begin(); it != m_hashTable.end(); )
+    QMutexLocker locker( &mutex );
+
+    for ( auto ramp : qAsConst( m_hashTable ) )
     {
-        if ( it.key().rhi == rhi )
+        auto& textures = ramp->textures;
+
+        for ( int i = textures.size() - 1; i >= 0; i-- )
         {
-            delete it.value();
-            it = m_hashTable.erase( it );
+            if ( textures[i].first == rhi )
+            {
+                delete textures[i].second;
+                textures.remove( i );
+
+                statistics.textureCount--;
+                statistics.bytes -= textureBytes;
+            }
+        }
+    }
+
+    for ( auto it = m_unusedRamps.begin(); it != m_unusedRamps.end(); )
+    {
+        auto ramp = *it;
+
+        if ( ramp->textures.isEmpty() )
+        {
+            it = m_unusedRamps.erase( it );
+            statistics.unusedCount--;
+
+            removeRamp( ramp );
         }
         else
         {
@@ -150,21 +352,52 @@ void Cache::cleanupRhi( const QRhi* rhi )
     m_rhiTable.removeAll( rhi );
 }
 
-QSGTexture* QskColorRamp::texture( const void* rhi,
+QskColorRamp::Ramp* QskColorRamp::acquireRamp(
     const QskGradientStops& stops, QskGradient::SpreadMode spreadMode )
 {
-    if ( s_cache == nullptr )
-    {
-        s_cache = new Cache();
+    auto cache = qskCache();
 
-        /*
-            For RHI we have QRhi::addCleanupCallback, but with
-            OpenGL we would have to fiddle around with QOpenGLSharedResource
-            But as the OpenGL path is only for Qt5 we do not want to spend
-            much energy on finetuning the resource management.
-         */
-        qAddPostRoutine( qskCleanupCache );
-    }
+    QMutexLocker locker( &cache->mutex );
+    return cache->acquireRamp( stops, spreadMode );
+}
+
+void QskColorRamp::releaseRamp( Ramp* ramp )
+{
+    if ( ramp == nullptr || s_cache == nullptr )
+        return;
+
+    QMutexLocker locker( &s_cache->mutex );
+    s_cache->releaseRamp( ramp );
+}
+
+QSGTexture* QskColorRamp::texture( const void* rhi, Ramp* ramp )
+{
+    auto cache = qskCache();
+
+    QMutexLocker locker( &cache->mutex );
+    return cache->texture( rhi, ramp );
+}
+
+void QskColorRamp::setMaxBytes( qint64 maxBytes )
+{
+    auto cache = qskCache();
+
+    QMutexLocker locker( &cache->mutex );
+    cache->maxBytes = qMax( maxBytes, qint64( 0 ) );
+}
+
+qint64 QskColorRamp::maxBytes()
+{
+    auto cache = qskCache();
+
+    QMutexLocker locker( &cache->mutex );
+    return cache->maxBytes;
+}
+
+QskColorRamp::Statistics QskColorRamp::statistics()
+{
+    auto cache = qskCache();
 
-    return s_cache->texture( rhi, stops, spreadMode );
+    QMutexLocker locker( &cache->mutex );
+    return cache->statistics;
 }
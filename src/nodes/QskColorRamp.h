@@ -13,8 +13,36 @@ class QSGTexture;
 
 namespace QskColorRamp
 {
-    QSGTexture* texture( const void* rhi,
-        const QskGradientStops&, QskGradient::SpreadMode );
+    class Ramp;
+
+    class Statistics
+    {
+      public:
+        int rampCount = 0;
+        int unusedCount = 0;
+        int textureCount = 0;
+
+        qint64 bytes = 0;
+
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 evictions = 0;
+    };
+
+    /*
+        Ramps are refcounted by the gradient materials. The textures
+        of ramps, that are not in use anymore, are kept until the
+        memory limit is exceeded and then deleted in LRU order.
+     */
+    Ramp* acquireRamp( const QskGradientStops&, QskGradient::SpreadMode );
+    void releaseRamp( Ramp* );
+
+    QSGTexture* texture( const void* rhi, Ramp* );
+
+    QSK_EXPORT void setMaxBytes( qint64 );
+    QSK_EXPORT qint64 maxBytes();
+
+    QSK_EXPORT Statistics statistics();
 }
 
 #endif
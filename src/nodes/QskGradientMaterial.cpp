@@ -106,8 +106,7 @@ namespace
 
             updateUniformValues( material );
 
-            auto texture = QskColorRamp::texture(
-                nullptr, material->stops(), material->spreadMode() );
+            auto texture = material->colorRampTexture( nullptr );
             texture->bind();
         }
 
@@ -145,8 +144,7 @@ namespace
 
             auto material = static_cast< const GradientMaterial* >( newMaterial );
 
-            auto texture = QskColorRamp::texture(
-                state.rhi(), material->stops(), material->spreadMode() );
+            auto texture = material->colorRampTexture( state.rhi() );
 
 #if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
             texture->updateRhiTexture( state.rhi(), state.resourceUpdateBatch() );
@@ -684,6 +682,41 @@ QskGradientMaterial::QskGradientMaterial( QskGradient::Type type )
 {
 }
 
+QskGradientMaterial::~QskGradientMaterial()
+{
+    QskColorRamp::releaseRamp( m_colorRamp );
+}
+
+void QskGradientMaterial::setStops( const QskGradientStops& stops )
+{
+    if ( m_colorRamp )
+    {
+        QskColorRamp::releaseRamp( m_colorRamp );
+        m_colorRamp = nullptr;
+    }
+
+    m_stops = stops;
+}
+
+void QskGradientMaterial::setSpreadMode( QskGradient::SpreadMode spreadMode )
+{
+    if ( m_colorRamp )
+    {
+        QskColorRamp::releaseRamp( m_colorRamp );
+        m_colorRamp = nullptr;
+    }
+
+    m_spreadMode = spreadMode;
+}
+
+QSGTexture* QskGradientMaterial::colorRampTexture( const void* rhi ) const
+{
+    if ( m_colorRamp == nullptr )
+        m_colorRamp = QskColorRamp::acquireRamp( m_stops, m_spreadMode );
+
+    return QskColorRamp::texture( rhi, m_colorRamp );
+}
+
 template< typename Material >
 inline Material* qskEnsureMaterial( QskGradientMaterial* material )
 {
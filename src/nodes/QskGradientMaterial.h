@@ -10,17 +10,27 @@
 #include "QskGradient.h"
 #include <qsgmaterial.h>
 
+namespace QskColorRamp
+{
+    class Ramp;
+}
+
 class QSK_EXPORT QskGradientMaterial : public QSGMaterial
 {
   public:
     static QskGradientMaterial* createMaterial( QskGradient::Type );
 
+    ~QskGradientMaterial() override;
+
     bool updateGradient( const QRectF&, const QskGradient& );
     QskGradient::Type gradientType() const;
 
     const QskGradientStops& stops() const;
     QskGradient::SpreadMode spreadMode() const;
 
+    // the texture with the colors of the stops
+    QSGTexture* colorRampTexture( const void* rhi ) const;
+
   protected:
     QskGradientMaterial( QskGradient::Type );
 
@@ -32,6 +42,9 @@ class QSK_EXPORT QskGradientMaterial : public QSGMaterial
 
     QskGradientStops m_stops;
     QskGradient::SpreadMode m_spreadMode = QskGradient::PadSpread;
+
+    // a reference to a ramp of the cache, acquired when being needed
+    mutable QskColorRamp::Ramp* m_colorRamp = nullptr;
 };
 
 inline QskGradient::Type QskGradientMaterial::gradientType() const
@@ -39,16 +52,6 @@ inline QskGradient::Type QskGradientMaterial::gradientType() const
     return m_gradientType;
 }
 
-inline void QskGradientMaterial::setStops( const QskGradientStops& stops )
-{
-    m_stops = stops;
-}
-
-inline void QskGradientMaterial::setSpreadMode( QskGradient::SpreadMode spreadMode )
-{
-    m_spreadMode = spreadMode;
-}
-
 inline const QskGradientStops& QskGradientMaterial::stops() const
 {
     return m_stops;
@@ -7,6 +7,7 @@
 #include "QskGraphic.h"
 #include "QskColorFilter.h"
 #include "QskPainterCommand.h"
+#include "QskTextureRenderer.h"
 
 namespace
 {
@@ -16,6 +17,27 @@ namespace
         const QskGraphic& graphic;
         const QskColorFilter& colorFilter;
     };
+
+    class PaintHelper final : public QskTextureRenderer::PaintHelper
+    {
+      public:
+        PaintHelper( const QskGraphic& graphic, const QskColorFilter& colorFilter )
+            : m_graphic( graphic )
+            , m_colorFilter( colorFilter )
+        {
+        }
+
+        void paint( QPainter* painter, const QSize& size ) override
+        {
+            const QRectF rect( 0, 0, size.width(), size.height() );
+            m_graphic.render( painter, rect, m_colorFilter, Qt::IgnoreAspectRatio );
+        }
+
+      private:
+        // copies, as the helper might be used from a worker thread
+        const QskGraphic m_graphic;
+        const QskColorFilter m_colorFilter;
+    };
 }
 
 QskGraphicNode::QskGraphicNode()
@@ -73,3 +95,10 @@ QskHashValue QskGraphicNode::hash( const void* nodeData ) const
 
     return graphic.hash( hash );
 }
+
+QskTextureRenderer::PaintHelper* QskGraphicNode::createPaintHelper(
+    const void* nodeData ) const
+{
+    const auto graphicData = reinterpret_cast< const GraphicData* >( nodeData );
+    return new PaintHelper( graphicData->graphic, graphicData->colorFilter );
+}
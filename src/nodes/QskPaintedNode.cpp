@@ -6,11 +6,18 @@
 #include "QskPaintedNode.h"
 #include "QskSGNode.h"
 #include "QskTextureRenderer.h"
+#include "QskTextureCache.h"
+#include "QskTextureAtlas.h"
 
 #include <qsgimagenode.h>
 #include <qquickwindow.h>
 #include <qimage.h>
 #include <qpainter.h>
+#include <qmutex.h>
+#include <qrunnable.h>
+#include <qthreadpool.h>
+
+#include <typeinfo>
 
 QSK_QT_PRIVATE_BEGIN
 #include <private/qsgplaintexture_p.h>
@@ -41,6 +48,128 @@ namespace
 
         return static_cast< QSGImageNode* >( node );
     }
+
+    inline void releaseTexture( QSGTexture* texture, const QRectF& sourceRect )
+    {
+        if ( texture == nullptr )
+            return;
+
+        if ( QskTextureAtlas::releaseSlot( texture, sourceRect ) )
+            return;
+
+        // textures, that are not known by the cache, are owned by us
+        if ( !QskTextureCache::releaseTexture( texture ) )
+            delete texture;
+    }
+
+    class PaintHelper : public QskTextureRenderer::PaintHelper
+    {
+      public:
+        PaintHelper( QskPaintedNode* node, const void* nodeData )
+            : m_node( node )
+            , m_nodeData( nodeData )
+        {
+        }
+
+        void paint( QPainter* painter, const QSize& size ) override
+        {
+            m_node->paint( painter, size, m_nodeData );
+        }
+
+      private:
+        QskPaintedNode* m_node;
+        const void* m_nodeData;
+    };
+}
+
+static QImage qskPaintImage( const QSize& size, qreal devicePixelRatio,
+    QskTextureRenderer::PaintHelper* helper )
+{
+    QImage image( size, QImage::Format_RGBA8888_Premultiplied );
+    image.fill( Qt::transparent );
+
+    QPainter painter( &image );
+
+    /*
+        setting a devicePixelRatio for the image only works for
+        value >= 1.0. So we have to scale manually.
+     */
+    painter.scale( devicePixelRatio, devicePixelRatio );
+
+    helper->paint( &painter, size / devicePixelRatio );
+
+    painter.end();
+
+    return image;
+}
+
+class QskPaintedNode::AsyncData
+{
+  public:
+    QMutex mutex;
+
+    // reset, when the node is deleted or switched to synchronous mode
+    QQuickWindow* window = nullptr;
+
+    quint64 serial = 0;
+    QSize size;
+
+    QImage image;
+    bool hasImage = false;
+};
+
+class QskPaintedNode::AsyncPainter final : public QRunnable
+{
+  public:
+    AsyncPainter( const std::shared_ptr< AsyncData >& data,
+            quint64 serial, QskTextureRenderer::PaintHelper* helper,
+            const QSize& size, qreal devicePixelRatio )
+        : m_data( data )
+        , m_helper( helper )
+        , m_serial( serial )
+        , m_size( size )
+        , m_devicePixelRatio( devicePixelRatio )
+    {
+    }
+
+    void run() override
+    {
+        if ( isOutdated() )
+            return;
+
+        const auto image = qskPaintImage( m_size, m_devicePixelRatio, m_helper.get() );
+
+        QMutexLocker locker( &m_data->mutex );
+
+        if ( m_data->window && ( m_data->serial == m_serial ) )
+        {
+            m_data->image = image;
+            m_data->hasImage = true;
+
+            // the image will be taken in QskPaintedNode::preprocess
+            QMetaObject::invokeMethod( m_data->window, "update", Qt::QueuedConnection );
+        }
+    }
+
+  private:
+    bool isOutdated() const
+    {
+        QMutexLocker locker( &m_data->mutex );
+        return ( m_data->window == nullptr ) || ( m_data->serial != m_serial );
+    }
+
+    const std::shared_ptr< AsyncData > m_data;
+    const std::unique_ptr< QskTextureRenderer::PaintHelper > m_helper;
+
+    const quint64 m_serial;
+    const QSize m_size;
+    const qreal m_devicePixelRatio;
+};
+
+static QThreadPool* qskPaintThreadPool()
+{
+    static QThreadPool pool;
+    return &pool;
 }
 
 QskPaintedNode::QskPaintedNode()
@@ -49,6 +178,84 @@ QskPaintedNode::QskPaintedNode()
 
 QskPaintedNode::~QskPaintedNode()
 {
+    if ( m_asyncData )
+    {
+        // running jobs still hold a reference, but will drop their results
+        QMutexLocker locker( &m_asyncData->mutex );
+        m_asyncData->window = nullptr;
+    }
+
+    if ( m_sharedTexture )
+        removeImageNode();
+}
+
+void QskPaintedNode::setAsynchronous( bool on )
+{
+    if ( on == isAsynchronous() )
+        return;
+
+    if ( m_sharedTexture )
+    {
+        // the texture can't be shared in asynchronous mode
+        removeImageNode();
+        m_hash = 0;
+    }
+
+    if ( on )
+    {
+        m_asyncData = std::make_shared< AsyncData >();
+    }
+    else
+    {
+        {
+            // running jobs still hold a reference, but will drop their results
+            QMutexLocker locker( &m_asyncData->mutex );
+            m_asyncData->window = nullptr;
+        }
+
+        m_asyncData.reset();
+    }
+
+    setFlag( QSGNode::UsePreprocess, on );
+}
+
+bool QskPaintedNode::isAsynchronous() const
+{
+    return m_asyncData != nullptr;
+}
+
+void QskPaintedNode::setSharedTexture( bool on )
+{
+    if ( on == m_sharedTexture )
+        return;
+
+    if ( m_asyncData == nullptr )
+    {
+        // the ownership of the texture changes
+        removeImageNode();
+        m_hash = 0;
+    }
+
+    m_sharedTexture = on;
+}
+
+bool QskPaintedNode::hasSharedTexture() const
+{
+    return m_sharedTexture;
+}
+
+void QskPaintedNode::setAtlasTexture( bool on )
+{
+    if ( on != m_atlasTexture )
+    {
+        m_atlasTexture = on;
+        m_hash = 0; // enforcing an update
+    }
+}
+
+bool QskPaintedNode::hasAtlasTexture() const
+{
+    return m_atlasTexture;
 }
 
 void QskPaintedNode::setRenderHint( RenderHint renderHint )
@@ -84,6 +291,11 @@ QSize QskPaintedNode::textureSize() const
 {
     if ( const auto imageNode = findImageNode( this ) )
     {
+        // atlas textures are displayed partially
+        const auto sourceRect = imageNode->sourceRect();
+        if ( !sourceRect.isEmpty() )
+            return sourceRect.size().toSize();
+
         if ( auto texture = imageNode->texture() )
             return texture->textureSize();
     }
@@ -100,24 +312,21 @@ QRectF QskPaintedNode::rect() const
 void QskPaintedNode::update( QQuickWindow* window,
     const QRectF& rect, const QSizeF& size, const void* nodeData )
 {
-    auto imageNode = findImageNode( this );
-
     if ( rect.isEmpty() )
     {
-        if ( imageNode )
-        {
-            removeChildNode( imageNode );
-            delete imageNode;
-        }
-
+        removeImageNode();
         return;
     }
 
+    const bool isShared = m_sharedTexture && ( m_asyncData == nullptr );
+
+    auto imageNode = findImageNode( this );
     if ( imageNode == nullptr )
     {
         imageNode = window->createImageNode();
 
-        imageNode->setOwnsTexture( true );
+        // shared textures are owned by QskTextureCache
+        imageNode->setOwnsTexture( !isShared );
         QskSGNode::setNodeRole( imageNode, imageRole );
 
         appendChildNode( imageNode );
@@ -142,12 +351,18 @@ void QskPaintedNode::update( QQuickWindow* window,
     }
     else
     {
-        isTextureDirty = ( imageSize != textureSize() );
+        // in asynchronous mode we compare with the pending request
+        const auto size = m_asyncData ? m_asyncData->size : textureSize();
+        isTextureDirty = ( imageSize != size );
     }
 
-
     if ( isTextureDirty )
-        updateTexture( window, imageSize, nodeData );
+    {
+        if ( isShared )
+            updateSharedTexture( window, imageSize, nodeData );
+        else if ( !( m_asyncData && updateTextureAsync( window, imageSize, nodeData ) ) )
+            updateTexture( window, imageSize, nodeData );
+    }
 
     imageNode->setRect( rect );
     imageNode->setTextureCoordinatesTransform(
@@ -161,75 +376,206 @@ void QskPaintedNode::updateTexture( QQuickWindow* window,
 
     if ( ( m_renderHint == OpenGL ) && QskTextureRenderer::isOpenGLWindow( window ) )
     {
-        const auto textureId = createTextureGL( window, size, nodeData );
+        auto texture = imageNode->texture();
 
-        auto texture = qobject_cast< QSGPlainTexture* >( imageNode->texture() );
-        if ( texture == nullptr )
+        const auto textureId = QskTextureRenderer::textureIdGL( texture );
+        if ( textureId && ( texture->textureSize() == size ) )
         {
-            texture = new QSGPlainTexture;
-            texture->setHasAlphaChannel( true );
-            texture->setOwnsTexture( true );
+            // no need for a new texture, when the size has not changed
+            PaintHelper helper( this, nodeData );
+            QskTextureRenderer::repaintTextureGL( window, textureId, size, &helper );
 
-            imageNode->setTexture( texture );
+            imageNode->markDirty( QSGNode::DirtyMaterial );
+        }
+        else
+        {
+            // the previous texture id goes back to the pool
+            imageNode->setTexture( createTexture( window, size, nodeData ) );
         }
-
-        QskTextureRenderer::setTextureId( window, textureId, size, texture );
     }
     else
     {
-        const auto image = createImage( window, size, nodeData );
+        setImage( window, createImage( window, size, nodeData ) );
+    }
+}
 
-        if ( auto texture = qobject_cast< QSGPlainTexture* >( imageNode->texture() ) )
-            texture->setImage( image );
-        else
-            imageNode->setTexture( window->createTextureFromImage( image ) );
+void QskPaintedNode::updateSharedTexture( QQuickWindow* window,
+    const QSize& size, const void* nodeData )
+{
+    QSGTexture* texture = nullptr;
+    QRectF sourceRect; // empty: the complete texture
+
+    if ( m_hash != 0 )
+    {
+        const QskTextureCache::Key key { typeid( *this ).hash_code(), m_hash, size };
+
+        if ( m_atlasTexture && QskTextureAtlas::isAtlasSize( size ) )
+        {
+            QskTextureAtlas::Slot slot;
+
+            if ( !QskTextureAtlas::acquireSlot( window, key, slot ) )
+            {
+                /*
+                    When the atlas is full we fall back to a texture
+                    of its own. Painting twice is acceptable for this
+                    exceptional situation.
+                 */
+                QskTextureAtlas::insertSlot( window, key,
+                    createImage( window, size, nodeData ), slot );
+            }
+
+            texture = slot.texture;
+            sourceRect = slot.rect;
+        }
+
+        if ( texture == nullptr )
+        {
+            texture = QskTextureCache::acquireTexture( window, key );
+            if ( texture == nullptr )
+            {
+                texture = createTexture( window, size, nodeData );
+                QskTextureCache::insertTexture( window, key, texture );
+            }
+        }
     }
+    else
+    {
+        // without a hash the content can't be identified
+        texture = createTexture( window, size, nodeData );
+    }
+
+    auto imageNode = findImageNode( this );
+
+    const auto oldTexture = imageNode->texture();
+    const auto oldSourceRect = imageNode->sourceRect();
+
+    imageNode->setTexture( texture );
+    imageNode->setSourceRect( sourceRect );
+
+    releaseTexture( oldTexture, oldSourceRect );
 }
 
-QImage QskPaintedNode::createImage( QQuickWindow* window,
+bool QskPaintedNode::updateTextureAsync( QQuickWindow* window,
     const QSize& size, const void* nodeData )
 {
-    QImage image( size, QImage::Format_RGBA8888_Premultiplied );
-    image.fill( Qt::transparent );
+    const auto helper = createPaintHelper( nodeData );
+    if ( helper == nullptr )
+    {
+        // painting synchronously
+        QMutexLocker locker( &m_asyncData->mutex );
+        m_asyncData->size = size;
 
-    QPainter painter( &image );
+        return false;
+    }
 
-    /*
-        setting a devicePixelRatio for the image only works for
-        value >= 1.0. So we have to scale manually.
-     */
-    const auto ratio = window->effectiveDevicePixelRatio();
-    painter.scale( ratio, ratio );
+    auto imageNode = findImageNode( this );
+    if ( imageNode->texture() == nullptr )
+    {
+        // a transparent placeholder, until the first image is available
+        QImage image( 1, 1, QImage::Format_RGBA8888_Premultiplied );
+        image.fill( Qt::transparent );
 
-    paint( &painter, size / ratio, nodeData );
+        setImage( window, image );
+    }
 
-    painter.end();
+    quint64 serial;
 
-    return image;
+    {
+        QMutexLocker locker( &m_asyncData->mutex );
+
+        m_asyncData->window = window;
+        m_asyncData->size = size;
+
+        m_asyncData->image = QImage();
+        m_asyncData->hasImage = false;
+
+        // all jobs with a lower serial are outdated
+        serial = ++m_asyncData->serial;
+    }
+
+    qskPaintThreadPool()->start( new AsyncPainter( m_asyncData,
+        serial, helper, size, window->effectiveDevicePixelRatio() ) );
+
+    return true;
+}
+
+void QskPaintedNode::preprocess()
+{
+    if ( m_asyncData == nullptr )
+        return;
+
+    QQuickWindow* window;
+    QImage image;
+
+    {
+        QMutexLocker locker( &m_asyncData->mutex );
+
+        if ( !m_asyncData->hasImage )
+            return;
+
+        window = m_asyncData->window;
+        image = m_asyncData->image;
+
+        m_asyncData->image = QImage();
+        m_asyncData->hasImage = false;
+    }
+
+    if ( window && findImageNode( this ) )
+        setImage( window, image );
+}
+
+void QskPaintedNode::setImage( QQuickWindow* window, const QImage& image )
+{
+    auto imageNode = findImageNode( this );
+
+    auto texture = qobject_cast< QSGPlainTexture* >( imageNode->texture() );
+
+    // textures with a pooled texture id are not reused for images
+    if ( texture && QskTextureRenderer::textureIdGL( texture ) == 0 )
+        texture->setImage( image );
+    else
+        imageNode->setTexture( window->createTextureFromImage( image ) );
+}
+
+QImage QskPaintedNode::createImage( QQuickWindow* window,
+    const QSize& size, const void* nodeData )
+{
+    PaintHelper helper( this, nodeData );
+    return qskPaintImage( size, window->effectiveDevicePixelRatio(), &helper );
 }
 
 quint32 QskPaintedNode::createTextureGL(
     QQuickWindow* window, const QSize& size, const void* nodeData )
 {
-    class PaintHelper : public QskTextureRenderer::PaintHelper
+    PaintHelper helper( this, nodeData );
+    return QskTextureRenderer::createPaintedTextureGL( window, size, &helper );
+}
+
+QSGTexture* QskPaintedNode::createTexture(
+    QQuickWindow* window, const QSize& size, const void* nodeData )
+{
+    if ( ( m_renderHint == OpenGL ) && QskTextureRenderer::isOpenGLWindow( window ) )
     {
-      public:
-        PaintHelper( QskPaintedNode* node, const void* nodeData )
-            : m_node( node )
-            , m_nodeData( nodeData )
-        {
-        }
+        const auto textureId = createTextureGL( window, size, nodeData );
+        return QskTextureRenderer::createTextureGL( window, textureId, size );
+    }
 
-        void paint( QPainter* painter, const QSize& size ) override
-        {
-            m_node->paint( painter, size, m_nodeData );
-        }
+    return window->createTextureFromImage( createImage( window, size, nodeData ) );
+}
 
-      private:
-        QskPaintedNode* m_node;
-        const void* m_nodeData;
-    };
+void QskPaintedNode::removeImageNode()
+{
+    if ( auto imageNode = findImageNode( this ) )
+    {
+        if ( !imageNode->ownsTexture() )
+            releaseTexture( imageNode->texture(), imageNode->sourceRect() );
 
-    PaintHelper helper( this, nodeData );
-    return createPaintedTextureGL( window, size, &helper );
+        removeChildNode( imageNode );
+        delete imageNode;
+    }
+}
+
+QskTextureRenderer::PaintHelper* QskPaintedNode::createPaintHelper( const void* ) const
+{
+    return nullptr;
 }
@@ -8,10 +8,17 @@
 
 #include "QskGlobal.h"
 #include <qsgnode.h>
+#include <memory>
 
 class QQuickWindow;
 class QPainter;
 class QImage;
+class QSGTexture;
+
+namespace QskTextureRenderer
+{
+    class PaintHelper;
+}
 
 class QSK_EXPORT QskPaintedNode : public QSGNode
 {
@@ -39,6 +46,32 @@ class QSK_EXPORT QskPaintedNode : public QSGNode
     void setRenderHint( RenderHint );
     RenderHint renderHint() const;
 
+    /*
+        In asynchronous mode the texture is painted by the raster paint engine
+        in a worker thread. The node keeps the previous texture until the
+        new image is available and swaps it in when preprocessing the next frame.
+        Requests, that have been replaced by another one, are dropped.
+     */
+    void setAsynchronous( bool );
+    bool isAsynchronous() const;
+
+    /*
+        Nodes with a shared texture look up their texture in QskTextureCache
+        and reuse it, when another node has already painted the same content
+        in the same size. Shared textures are always painted synchronously and
+        the option is ignored in asynchronous mode.
+     */
+    void setSharedTexture( bool );
+    bool hasSharedTexture() const;
+
+    /*
+        Small shared textures can be stored in the pages of QskTextureAtlas,
+        so that the scene graph is able to batch the nodes. As the images are
+        painted by the raster paint engine the render hint is ignored.
+     */
+    void setAtlasTexture( bool );
+    bool hasAtlasTexture() const;
+
     void setMirrored( Qt::Orientations );
     Qt::Orientations mirrored() const;
 
@@ -47,21 +80,45 @@ class QSK_EXPORT QskPaintedNode : public QSGNode
 
     virtual void paint( QPainter*, const QSize&, const void* nodeData ) = 0;
 
+    void preprocess() override;
+
   protected:
     void update( QQuickWindow*, const QRectF&, const QSizeF&, const void* nodeData );
 
     // a hash value of '0' always results in repainting
     virtual QskHashValue hash( const void* nodeData ) const = 0;
 
+    /*
+        For painting in a worker thread the node has to provide a helper
+        with its own copy of the node data. The default implementation
+        returns nullptr, what results in painting synchronously.
+     */
+    virtual QskTextureRenderer::PaintHelper* createPaintHelper(
+        const void* nodeData ) const;
+
   private:
     void updateTexture( QQuickWindow*, const QSize&, const void* nodeData );
+    bool updateTextureAsync( QQuickWindow*, const QSize&, const void* nodeData );
+    void updateSharedTexture( QQuickWindow*, const QSize&, const void* nodeData );
+
+    void setImage( QQuickWindow*, const QImage& );
 
     QImage createImage( QQuickWindow*, const QSize&, const void* nodeData );
     quint32 createTextureGL( QQuickWindow*, const QSize&, const void* nodeData );
+    QSGTexture* createTexture( QQuickWindow*, const QSize&, const void* nodeData );
+
+    void removeImageNode();
+
+    class AsyncData;
+    class AsyncPainter;
+
+    std::shared_ptr< AsyncData > m_asyncData;
 
     RenderHint m_renderHint = OpenGL;
     Qt::Orientations m_mirrored;
     QskHashValue m_hash = 0;
+    bool m_sharedTexture = false;
+    bool m_atlasTexture = false;
 };
 
 #endif
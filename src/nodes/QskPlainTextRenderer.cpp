@@ -6,6 +6,7 @@
 #include "QskPlainTextRenderer.h"
 #include "QskTextColors.h"
 #include "QskTextOptions.h"
+#include "QskTextCache.h"
 
 #include <qfontmetrics.h>
 #include <qmath.h>
@@ -30,10 +31,7 @@ QRectF QskPlainTextRenderer::textRect(
     const QString& text, const QFont& font, const QskTextOptions& options,
     const QSizeF& size )
 {
-    const QFontMetricsF fm( font );
-    const QRectF r( 0, 0, size.width(), size.height() );
-
-    return fm.boundingRect( r, options.textFlags(), text );
+    return QskTextCache::boundingRect( font, size, options.textFlags(), text );
 }
 
 static qreal qskLayoutText( QTextLayout* layout,
@@ -96,9 +94,63 @@ static qreal qskLayoutText( QTextLayout* layout,
     return y;
 }
 
+static QskTextCache::GlyphLayout qskGlyphLayout( const QString& text,
+    const QFont& font, const QskTextOptions& options,
+    Qt::Alignment alignment, qreal lineWidth )
+{
+    QskTextCache::GlyphLayout glyphLayout;
+
+    if ( QskTextCache::acquireGlyphLayout(
+        text, font, options, alignment, lineWidth, glyphLayout ) )
+    {
+        return glyphLayout;
+    }
+
+    QTextOption textOption( alignment );
+    textOption.setWrapMode( static_cast< QTextOption::WrapMode >( options.wrapMode() ) );
+
+    QString tmp = text;
+
+#if 0
+    const int pos = tmp.indexOf( QLatin1Char( '\x9c' ) );
+    if ( pos != -1 )
+    {
+        // ST: string termination
+
+        tmp = tmp.mid( 0, pos );
+        tmp.replace( QLatin1Char( '\n' ), QChar::LineSeparator );
+    }
+    else
+#endif
+    if ( tmp.contains( QLatin1Char( '\n' ) ) )
+    {
+        tmp.replace( QLatin1Char('\n'), QChar::LineSeparator );
+    }
+
+    QTextLayout layout;
+    layout.setFont( font );
+    layout.setTextOption( textOption );
+    layout.setText( tmp );
+
+    layout.beginLayout();
+    glyphLayout.height = qskLayoutText( &layout, lineWidth, options );
+    layout.endLayout();
+
+    glyphLayout.boundingHeight = layout.boundingRect().height();
+
+    for ( int i = 0; i < layout.lineCount(); ++i )
+        glyphLayout.glyphRuns += layout.lineAt( i ).glyphRuns();
+
+    QskTextCache::insertGlyphLayout(
+        text, font, options, alignment, lineWidth, glyphLayout );
+
+    return glyphLayout;
+}
+
 static void qskRenderText(
-    QQuickItem* item, QSGNode* parentNode, const QTextLayout& layout, qreal baseLine,
-    const QColor& color, QQuickText::TextStyle style, const QColor& styleColor )
+    QQuickItem* item, QSGNode* parentNode, const QList< QGlyphRun >& glyphRuns,
+    qreal baseLine, const QColor& color, QQuickText::TextStyle style,
+    const QColor& styleColor )
 {
     auto renderContext = QQuickItemPrivate::get(item)->sceneGraphRenderContext();
     auto sgContext = renderContext->sceneGraphContext();
@@ -120,39 +172,34 @@ static void qskRenderText(
 
     const QPointF position( 0, baseLine );
 
-    for ( int i = 0; i < layout.lineCount(); ++i )
+    for ( const auto& glyphRun : glyphRuns )
     {
-        const auto glyphRuns = layout.lineAt( i ).glyphRuns();
-
-        for ( const auto& glyphRun : glyphRuns )
+        if ( glyphNode == nullptr )
         {
-            if ( glyphNode == nullptr )
-            {
-                const bool preferNativeGlyphNode = false; // QskTextOptions?
+            const bool preferNativeGlyphNode = false; // QskTextOptions?
 
 #if QT_VERSION >= QT_VERSION_CHECK( 6, 0, 0 )
-                constexpr int renderQuality = -1; // QQuickText::DefaultRenderTypeQuality
-                glyphNode = sgContext->createGlyphNode(
-                    renderContext, preferNativeGlyphNode, renderQuality );
+            constexpr int renderQuality = -1; // QQuickText::DefaultRenderTypeQuality
+            glyphNode = sgContext->createGlyphNode(
+                renderContext, preferNativeGlyphNode, renderQuality );
 #else
-                glyphNode = sgContext->createGlyphNode(
-                    renderContext, preferNativeGlyphNode );
+            glyphNode = sgContext->createGlyphNode(
+                renderContext, preferNativeGlyphNode );
 #endif
-                glyphNode->setOwnerElement( item );
-                glyphNode->setFlags( QSGNode::OwnedByParent | GlyphFlag );
-            }
+            glyphNode->setOwnerElement( item );
+            glyphNode->setFlags( QSGNode::OwnedByParent | GlyphFlag );
+        }
 
-            glyphNode->setStyle( style );
-            glyphNode->setColor( color );
-            glyphNode->setStyleColor( styleColor );
-            glyphNode->setGlyphs( position, glyphRun );
-            glyphNode->update();
+        glyphNode->setStyle( style );
+        glyphNode->setColor( color );
+        glyphNode->setStyleColor( styleColor );
+        glyphNode->setGlyphs( position, glyphRun );
+        glyphNode->update();
 
-            if ( glyphNode->parent() != parentNode )
-                parentNode->appendChildNode( glyphNode );
+        if ( glyphNode->parent() != parentNode )
+            parentNode->appendChildNode( glyphNode );
 
-            glyphNode = static_cast< QSGGlyphNode* >( glyphNode->nextSibling() );
-        }
+        glyphNode = static_cast< QSGGlyphNode* >( glyphNode->nextSibling() );
     }
 
     // Remove leftover glyphs
@@ -174,36 +221,8 @@ void QskPlainTextRenderer::updateNode( const QString& text,
     Qt::Alignment alignment, const QRectF& rect,
     const QQuickItem* item, QSGTransformNode* node )
 {
-    QTextOption textOption( alignment );
-    textOption.setWrapMode( static_cast< QTextOption::WrapMode >( options.wrapMode() ) );
-
-    QString tmp = text;
-
-#if 0
-    const int pos = tmp.indexOf( QLatin1Char( '\x9c' ) );
-    if ( pos != -1 )
-    {
-        // ST: string termination
-
-        tmp = tmp.mid( 0, pos );
-        tmp.replace( QLatin1Char( '\n' ), QChar::LineSeparator );
-    }
-    else
-#endif
-    if ( tmp.contains( QLatin1Char( '\n' ) ) )
-    {
-        tmp.replace( QLatin1Char('\n'), QChar::LineSeparator );
-    }
-
-
-    QTextLayout layout;
-    layout.setFont( font );
-    layout.setTextOption( textOption );
-    layout.setText( tmp );
-
-    layout.beginLayout();
-    const qreal textHeight = qskLayoutText( &layout, rect.width(), options );
-    layout.endLayout();
+    const auto glyphLayout = qskGlyphLayout(
+        text, font, options, alignment, rect.width() );
 
     const qreal y0 = QFontMetricsF( font ).ascent();
 
@@ -211,11 +230,11 @@ void QskPlainTextRenderer::updateNode( const QString& text,
 
     if ( alignment & Qt::AlignVCenter )
     {
-        yBaseline += ( rect.height() - textHeight ) * 0.5;
+        yBaseline += ( rect.height() - glyphLayout.height ) * 0.5;
     }
     else if ( alignment & Qt::AlignBottom )
     {
-        yBaseline += rect.height() - textHeight;
+        yBaseline += rect.height() - glyphLayout.height;
     }
 
     if ( yBaseline != y0 )
@@ -226,12 +245,12 @@ void QskPlainTextRenderer::updateNode( const QString& text,
             between margins/paddings.
          */
 
-        const int bh = int( layout.boundingRect().height() );
+        const int bh = int( glyphLayout.boundingHeight );
         yBaseline = ( bh % 2 ) ? qFloor( yBaseline ) : qCeil( yBaseline );
     }
 
     qskRenderText(
-        const_cast< QQuickItem* >( item ), node, layout, yBaseline,
+        const_cast< QQuickItem* >( item ), node, glyphLayout.glyphRuns, yBaseline,
         colors.textColor, static_cast< QQuickText::TextStyle >( style ),
         colors.styleColor );
 }
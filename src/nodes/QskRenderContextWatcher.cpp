@@ -0,0 +1,36 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskRenderContextWatcher.h"
+
+QSK_QT_PRIVATE_BEGIN
+#include <private/qsgcontext_p.h>
+QSK_QT_PRIVATE_END
+
+QskRenderContextWatcher::QskRenderContextWatcher( PurgeFunction purge )
+    : m_purge( purge )
+{
+}
+
+void QskRenderContextWatcher::watch( QSGRenderContext* context )
+{
+    if ( m_contexts.count( context ) )
+        return;
+
+    m_contexts.insert( context );
+
+    const auto purge = m_purge;
+
+    QObject::connect( context, &QSGRenderContext::invalidated,
+        context, [ purge, context ] { purge( context ); }, Qt::DirectConnection );
+
+    QObject::connect( context, &QObject::destroyed,
+        [ purge, context ] { purge( context ); } );
+}
+
+void QskRenderContextWatcher::forget( const QSGRenderContext* context )
+{
+    m_contexts.erase( context );
+}
@@ -0,0 +1,42 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_RENDER_CONTEXT_WATCHER_H
+#define QSK_RENDER_CONTEXT_WATCHER_H
+
+#include "QskGlobal.h"
+#include <unordered_set>
+
+class QSGRenderContext;
+
+/*
+    Caches of scene graph resources have to drop the resources of
+    a render context, when it gets invalidated. As a new context
+    might be created at the same address, this also has to be done,
+    when the context is destroyed.
+
+    The watcher is not thread safe - the caches call it with
+    their mutex being locked.
+ */
+class QskRenderContextWatcher
+{
+  public:
+    // called from the thread of the context, without any lock
+    using PurgeFunction = void ( * )( const QSGRenderContext* );
+
+    QskRenderContextWatcher( PurgeFunction );
+
+    // connects to the context, unless it is already watched
+    void watch( QSGRenderContext* );
+
+    // to be called, when the resources of the context have been purged
+    void forget( const QSGRenderContext* );
+
+  private:
+    const PurgeFunction m_purge;
+    std::unordered_set< const QSGRenderContext* > m_contexts;
+};
+
+#endif
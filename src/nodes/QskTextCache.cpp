@@ -0,0 +1,276 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskTextCache.h"
+#include "QskTextOptions.h"
+#include "QskFunctions.h"
+
+#include <qcache.h>
+#include <qfont.h>
+#include <qfontmetrics.h>
+#include <qmutex.h>
+#include <qthreadstorage.h>
+#include <qvector.h>
+
+namespace
+{
+    /*
+        textFlags < 0 indicates a horizontal advance
+        instead of a bounding rectangle
+     */
+    class ExtentKey
+    {
+      public:
+        inline bool operator==( const ExtentKey& other ) const
+        {
+            return ( textFlags == other.textFlags ) && ( size == other.size )
+                && ( text == other.text ) && ( font == other.font );
+        }
+
+        QString text;
+        QFont font;
+        int textFlags;
+        QSizeF size;
+    };
+
+    inline QskHashValue qHash( const ExtentKey& key, QskHashValue seed = 0 )
+    {
+        auto hash = ::qHash( key.text, seed );
+        hash = ::qHash( key.font, hash );
+        hash = ::qHash( key.textFlags, hash );
+        hash = ::qHash( key.size.width(), hash );
+        hash = ::qHash( key.size.height(), hash );
+
+        return hash;
+    }
+
+    class LayoutKey
+    {
+      public:
+        inline bool operator==( const LayoutKey& other ) const
+        {
+            return ( lineWidth == other.lineWidth ) && ( alignment == other.alignment )
+                && ( options == other.options )
+                && ( text == other.text ) && ( font == other.font );
+        }
+
+        QString text;
+        QFont font;
+        QskTextOptions options;
+        int alignment;
+        qreal lineWidth;
+    };
+
+    inline QskHashValue qHash( const LayoutKey& key, QskHashValue seed = 0 )
+    {
+        auto hash = ::qHash( key.text, seed );
+        hash = ::qHash( key.font, hash );
+        hash = key.options.hash( hash );
+        hash = ::qHash( key.alignment, hash );
+        hash = ::qHash( key.lineWidth, hash );
+
+        return hash;
+    }
+
+    /*
+        The glyph layouts of a thread. It is deleted, when the
+        thread finishes, so that we never reuse glyph runs referring
+        to the font engines of a dead thread.
+     */
+    class LayoutCache
+    {
+      public:
+        LayoutCache( int maxCost )
+            : layouts( maxCost )
+        {
+        }
+
+        ~LayoutCache();
+
+        QCache< LayoutKey, QskTextCache::GlyphLayout > layouts;
+    };
+
+    class Cache
+    {
+      public:
+        QMutex mutex;
+
+        QCache< ExtentKey, QRectF > extents { 2000 };
+
+        QThreadStorage< LayoutCache* > threadLayouts;
+        QVector< LayoutCache* > layoutCaches;
+        int maxLayouts = 200;
+
+        quint64 hits = 0;
+        quint64 misses = 0;
+    };
+}
+
+Q_GLOBAL_STATIC( Cache, qskCache )
+
+LayoutCache::~LayoutCache()
+{
+    // called from the finishing thread
+    if ( !qskCache.isDestroyed() )
+    {
+        auto cache = qskCache();
+
+        QMutexLocker locker( &cache->mutex );
+        cache->layoutCaches.removeOne( this );
+    }
+}
+
+static LayoutCache* qskLayoutCache( Cache* cache, bool create )
+{
+    // the mutex has to be locked
+
+    if ( cache->threadLayouts.hasLocalData() )
+        return cache->threadLayouts.localData();
+
+    if ( !create )
+        return nullptr;
+
+    auto layoutCache = new LayoutCache( cache->maxLayouts );
+
+    cache->threadLayouts.setLocalData( layoutCache );
+    cache->layoutCaches += layoutCache;
+
+    return layoutCache;
+}
+
+static inline LayoutKey qskLayoutKey( const QString& text, const QFont& font,
+    const QskTextOptions& options, Qt::Alignment alignment, qreal lineWidth )
+{
+    return { text, font, options, static_cast< int >( alignment ), lineWidth };
+}
+
+static QRectF qskExtent( const ExtentKey& key )
+{
+    auto cache = qskCache();
+
+    {
+        QMutexLocker locker( &cache->mutex );
+
+        if ( const auto rect = cache->extents.object( key ) )
+        {
+            cache->hits++;
+            return *rect;
+        }
+
+        cache->misses++;
+    }
+
+    const QFontMetricsF fm( key.font );
+
+    QRectF rect;
+
+    if ( key.textFlags < 0 )
+    {
+        rect.setWidth( qskHorizontalAdvance( fm, key.text ) );
+    }
+    else
+    {
+        const QRectF r( 0.0, 0.0, key.size.width(), key.size.height() );
+        rect = fm.boundingRect( r, key.textFlags, key.text );
+    }
+
+    QMutexLocker locker( &cache->mutex );
+    cache->extents.insert( key, new QRectF( rect ) );
+
+    return rect;
+}
+
+QRectF QskTextCache::boundingRect( const QFont& font,
+    const QSizeF& size, int textFlags, const QString& text )
+{
+    return qskExtent( { text, font, textFlags, size } );
+}
+
+qreal QskTextCache::horizontalAdvance( const QFont& font, const QString& text )
+{
+    return qskExtent( { text, font, -1, QSizeF() } ).width();
+}
+
+bool QskTextCache::acquireGlyphLayout( const QString& text, const QFont& font,
+    const QskTextOptions& options, Qt::Alignment alignment, qreal lineWidth,
+    GlyphLayout& glyphLayout )
+{
+    const auto key = qskLayoutKey( text, font, options, alignment, lineWidth );
+
+    auto cache = qskCache();
+
+    QMutexLocker locker( &cache->mutex );
+
+    if ( auto layoutCache = qskLayoutCache( cache, false ) )
+    {
+        if ( const auto layout = layoutCache->layouts.object( key ) )
+        {
+            glyphLayout = *layout;
+            cache->hits++;
+
+            return true;
+        }
+    }
+
+    cache->misses++;
+    return false;
+}
+
+void QskTextCache::insertGlyphLayout( const QString& text, const QFont& font,
+    const QskTextOptions& options, Qt::Alignment alignment, qreal lineWidth,
+    const GlyphLayout& glyphLayout )
+{
+    const auto key = qskLayoutKey( text, font, options, alignment, lineWidth );
+
+    auto cache = qskCache();
+
+    QMutexLocker locker( &cache->mutex );
+
+    auto layoutCache = qskLayoutCache( cache, true );
+    layoutCache->layouts.insert( key, new GlyphLayout( glyphLayout ) );
+}
+
+void QskTextCache::setMaxEntries( int extents, int layouts )
+{
+    auto cache = qskCache();
+
+    QMutexLocker locker( &cache->mutex );
+
+    cache->extents.setMaxCost( qMax( extents, 0 ) );
+
+    cache->maxLayouts = qMax( layouts, 0 );
+    for ( auto layoutCache : qAsConst( cache->layoutCaches ) )
+        layoutCache->layouts.setMaxCost( cache->maxLayouts );
+}
+
+void QskTextCache::clear()
+{
+    auto cache = qskCache();
+
+    QMutexLocker locker( &cache->mutex );
+
+    cache->extents.clear();
+
+    for ( auto layoutCache : qAsConst( cache->layoutCaches ) )
+        layoutCache->layouts.clear();
+}
+
+QskTextCache::Statistics QskTextCache::statistics()
+{
+    auto cache = qskCache();
+
+    QMutexLocker locker( &cache->mutex );
+
+    Statistics statistics;
+    statistics.extentCount = cache->extents.count();
+
+    for ( const auto layoutCache : qAsConst( cache->layoutCaches ) )
+        statistics.layoutCount += layoutCache->layouts.count();
+
+    statistics.hits = cache->hits;
+    statistics.misses = cache->misses;
+
+    return statistics;
+}
@@ -0,0 +1,76 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_TEXT_CACHE_H
+#define QSK_TEXT_CACHE_H
+
+#include "QskGlobal.h"
+
+#include <qglyphrun.h>
+#include <qlist.h>
+#include <qnamespace.h>
+
+class QskTextOptions;
+
+class QString;
+class QFont;
+class QRectF;
+class QSizeF;
+
+/*
+    Measuring and shaping texts is expensive, but the same texts
+    are usually measured several times: for the size hints, when
+    laying out and when updating the nodes. So the results are
+    stored in bounded LRU caches, that are shared between all controls.
+ */
+namespace QskTextCache
+{
+    class GlyphLayout
+    {
+      public:
+        QList< QGlyphRun > glyphRuns;
+
+        // height of all lines, including leading
+        qreal height = 0.0;
+
+        // height of QTextLayout::boundingRect
+        qreal boundingHeight = 0.0;
+    };
+
+    class Statistics
+    {
+      public:
+        int extentCount = 0;
+        int layoutCount = 0;
+
+        quint64 hits = 0;
+        quint64 misses = 0;
+    };
+
+    // QFontMetricsF::boundingRect
+    QSK_EXPORT QRectF boundingRect( const QFont&,
+        const QSizeF&, int textFlags, const QString& );
+
+    // QFontMetricsF::horizontalAdvance
+    QSK_EXPORT qreal horizontalAdvance( const QFont&, const QString& );
+
+    /*
+        Glyph runs can't be shared between threads, so they
+        are cached for the calling thread only and are dropped,
+        when the thread finishes.
+     */
+    bool acquireGlyphLayout( const QString&, const QFont&, const QskTextOptions&,
+        Qt::Alignment, qreal lineWidth, GlyphLayout& );
+
+    void insertGlyphLayout( const QString&, const QFont&, const QskTextOptions&,
+        Qt::Alignment, qreal lineWidth, const GlyphLayout& );
+
+    QSK_EXPORT void setMaxEntries( int extents, int layouts );
+    QSK_EXPORT void clear();
+
+    QSK_EXPORT Statistics statistics();
+}
+
+#endif
@@ -0,0 +1,514 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskTextureAtlas.h"
+#include "QskRenderContextWatcher.h"
+
+#include <qimage.h>
+#include <qmutex.h>
+#include <qpainter.h>
+#include <qquickwindow.h>
+
+QSK_QT_PRIVATE_BEGIN
+#include <private/qquickwindow_p.h>
+#include <private/qsgcontext_p.h>
+#include <private/qsgplaintexture_p.h>
+QSK_QT_PRIVATE_END
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+static void qskPurgeContext( const QSGRenderContext* );
+
+namespace
+{
+    const int pageSize = 512;
+
+    // 1 pixel around each cell avoids bleeding, when filtering linearly
+    const int padding = 1;
+
+    const int cellSizes[] = { 16, 32, 64 };
+
+    class AtlasKey
+    {
+      public:
+        inline bool operator==( const AtlasKey& other ) const
+        {
+            return ( context == other.context ) && ( type == other.type )
+                && ( hash == other.hash ) && ( size == other.size );
+        }
+
+        const QSGRenderContext* context;
+        size_t type;
+        QskHashValue hash;
+        QSize size;
+    };
+
+    class AtlasKeyHash
+    {
+      public:
+        inline size_t operator()( const AtlasKey& key ) const
+        {
+            auto value = qHash( key.context, key.hash );
+            value = qHash( key.type, value );
+            value = qHash( key.size.width(), value );
+            value = qHash( key.size.height(), value );
+
+            return value;
+        }
+    };
+
+    class Page;
+
+    class Entry
+    {
+      public:
+        AtlasKey key;
+
+        Page* page;
+        int cell;
+
+        int refCount;
+        quint64 lastUse;
+    };
+
+    class Page
+    {
+      public:
+        Page( const QSGRenderContext* context, int cellSize )
+            : context( context )
+            , cellSize( cellSize )
+            , columns( pageSize / ( cellSize + 2 * padding ) )
+            , cells( columns * columns, nullptr )
+            , image( pageSize, pageSize, QImage::Format_RGBA8888_Premultiplied )
+        {
+            image.fill( Qt::transparent );
+        }
+
+        inline int extent() const { return cellSize + 2 * padding; }
+
+        inline QPoint cellPos( int cell ) const
+        {
+            return QPoint( ( cell % columns ) * extent(), ( cell / columns ) * extent() );
+        }
+
+        inline int cellAt( const QPointF& pos ) const
+        {
+            const int col = int( pos.x() ) / extent();
+            const int row = int( pos.y() ) / extent();
+
+            return row * columns + col;
+        }
+
+        int freeCell() const
+        {
+            if ( storedCount < static_cast< int >( cells.size() ) )
+            {
+                const auto it = std::find( cells.begin(), cells.end(), nullptr );
+                return static_cast< int >( it - cells.begin() );
+            }
+
+            return -1;
+        }
+
+        // nullptr, when the context has been invalidated
+        const QSGRenderContext* context;
+
+        const int cellSize;
+        const int columns;
+
+        std::vector< Entry* > cells;
+
+        int storedCount = 0;
+        int usedCount = 0;
+
+        QImage image;
+        QSGTexture* texture = nullptr;
+    };
+
+    class Atlas
+    {
+      public:
+        QMutex mutex;
+
+        std::vector< Page* > pages;
+
+        std::unordered_map< AtlasKey, Entry*, AtlasKeyHash > keyMap;
+        std::unordered_map< const QSGTexture*, Page* > textureMap;
+
+        QskRenderContextWatcher contextWatcher { qskPurgeContext };
+
+        int maxPages = 8;
+        quint64 serial = 0;
+
+        QskTextureAtlas::Statistics statistics;
+    };
+}
+
+Q_GLOBAL_STATIC( Atlas, qskAtlas )
+
+static inline AtlasKey qskAtlasKey(
+    const QQuickWindow* window, const QskTextureCache::Key& key )
+{
+    auto w = const_cast< QQuickWindow* >( window );
+    return { QQuickWindowPrivate::get( w )->context, key.type, key.hash, key.size };
+}
+
+static inline int qskCellSize( const QSize& size )
+{
+    const int length = qMax( size.width(), size.height() );
+
+    for ( const auto cellSize : cellSizes )
+    {
+        if ( length <= cellSize )
+            return cellSize;
+    }
+
+    return -1;
+}
+
+static inline QskTextureAtlas::Slot qskSlot( const Entry* entry )
+{
+    const auto page = entry->page;
+    const auto pos = page->cellPos( entry->cell ) + QPoint( padding, padding );
+
+    QskTextureAtlas::Slot slot;
+    slot.texture = page->texture;
+    slot.rect = QRectF( pos, entry->key.size );
+
+    return slot;
+}
+
+static void qskDeletePage( Atlas* atlas, Page* page )
+{
+    atlas->pages.erase( std::find( atlas->pages.begin(), atlas->pages.end(), page ) );
+    atlas->textureMap.erase( page->texture );
+
+    for ( auto entry : page->cells )
+    {
+        if ( entry )
+        {
+            auto it = atlas->keyMap.find( entry->key );
+            if ( it != atlas->keyMap.end() && it->second == entry )
+                atlas->keyMap.erase( it );
+
+            delete entry;
+        }
+    }
+
+    delete page->texture;
+    delete page;
+}
+
+static void qskRemoveEntry( Atlas* atlas, Entry* entry )
+{
+    auto it = atlas->keyMap.find( entry->key );
+    if ( it != atlas->keyMap.end() && it->second == entry )
+        atlas->keyMap.erase( it );
+
+    auto page = entry->page;
+
+    page->cells[ entry->cell ] = nullptr;
+    page->storedCount--;
+
+    delete entry;
+}
+
+static void qskPurgeContext( const QSGRenderContext* context )
+{
+    auto atlas = qskAtlas();
+
+    QMutexLocker locker( &atlas->mutex );
+
+    const auto pages = atlas->pages;
+    for ( auto page : pages )
+    {
+        if ( page->context != context )
+            continue;
+
+        if ( page->usedCount == 0 )
+        {
+            qskDeletePage( atlas, page );
+            continue;
+        }
+
+        /*
+            The page is still in use. We only forget about it and
+            delete it, when the last cell has been released.
+         */
+        page->context = nullptr;
+
+        for ( auto entry : page->cells )
+        {
+            if ( entry == nullptr )
+                continue;
+
+            if ( entry->refCount == 0 )
+                qskRemoveEntry( atlas, entry );
+            else
+                atlas->keyMap.erase( entry->key );
+        }
+    }
+
+    atlas->contextWatcher.forget( context );
+}
+
+static Page* qskCreatePage( Atlas* atlas,
+    QQuickWindow* window, const QSGRenderContext* context, int cellSize )
+{
+    auto page = new Page( context, cellSize );
+
+    page->texture = window->createTextureFromImage( page->image );
+
+    if ( qobject_cast< QSGPlainTexture* >( page->texture ) == nullptr )
+    {
+        // we need to be able to update the texture
+        delete page->texture;
+        delete page;
+
+        return nullptr;
+    }
+
+    atlas->pages.push_back( page );
+    atlas->textureMap[ page->texture ] = page;
+
+    return page;
+}
+
+static Entry* qskEvictEntry( Atlas* atlas,
+    const QSGRenderContext* context, int cellSize )
+{
+    Entry* lru = nullptr;
+
+    for ( auto page : atlas->pages )
+    {
+        if ( page->context != context || page->cellSize != cellSize )
+            continue;
+
+        for ( auto entry : page->cells )
+        {
+            if ( entry && entry->refCount == 0 )
+            {
+                if ( lru == nullptr || entry->lastUse < lru->lastUse )
+                    lru = entry;
+            }
+        }
+    }
+
+    return lru;
+}
+
+static Page* qskEmptyPage( Atlas* atlas, const QSGRenderContext* context )
+{
+    for ( auto page : atlas->pages )
+    {
+        if ( page->context == context && page->storedCount == 0 )
+            return page;
+    }
+
+    return nullptr;
+}
+
+bool QskTextureAtlas::isAtlasSize( const QSize& size )
+{
+    return !size.isEmpty() && qskCellSize( size ) > 0;
+}
+
+bool QskTextureAtlas::acquireSlot(
+    const QQuickWindow* window, const QskTextureCache::Key& key, Slot& slot )
+{
+    auto atlas = qskAtlas();
+
+    QMutexLocker locker( &atlas->mutex );
+
+    auto it = atlas->keyMap.find( qskAtlasKey( window, key ) );
+    if ( it == atlas->keyMap.end() )
+    {
+        atlas->statistics.misses++;
+        return false;
+    }
+
+    auto entry = it->second;
+
+    if ( entry->refCount++ == 0 )
+        entry->page->usedCount++;
+
+    entry->lastUse = ++atlas->serial;
+    atlas->statistics.hits++;
+
+    slot = qskSlot( entry );
+    return true;
+}
+
+bool QskTextureAtlas::insertSlot( QQuickWindow* window,
+    const QskTextureCache::Key& key, const QImage& image, Slot& slot )
+{
+    const int cellSize = qskCellSize( image.size() );
+    if ( cellSize <= 0 || image.isNull() )
+        return false;
+
+    auto atlas = qskAtlas();
+
+    QMutexLocker locker( &atlas->mutex );
+
+    const auto atlasKey = qskAtlasKey( window, key );
+
+    if ( atlas->keyMap.count( atlasKey ) )
+    {
+        qWarning( "QskTextureAtlas: image has already been inserted" );
+        return false;
+    }
+
+    Page* page = nullptr;
+    int cell = -1;
+
+    for ( auto p : atlas->pages )
+    {
+        if ( p->context == atlasKey.context && p->cellSize == cellSize )
+        {
+            cell = p->freeCell();
+            if ( cell >= 0 )
+            {
+                page = p;
+                break;
+            }
+        }
+    }
+
+    if ( page == nullptr )
+    {
+        if ( static_cast< int >( atlas->pages.size() ) >= atlas->maxPages )
+        {
+            if ( auto entry = qskEvictEntry( atlas, atlasKey.context, cellSize ) )
+            {
+                page = entry->page;
+                cell = entry->cell;
+
+                qskRemoveEntry( atlas, entry );
+                atlas->statistics.evictions++;
+            }
+            else if ( auto emptyPage = qskEmptyPage( atlas, atlasKey.context ) )
+            {
+                // a page, that is not needed for its size anymore
+                qskDeletePage( atlas, emptyPage );
+            }
+        }
+
+        if ( page == nullptr
+            && static_cast< int >( atlas->pages.size() ) < atlas->maxPages )
+        {
+            page = qskCreatePage( atlas, window, atlasKey.context, cellSize );
+            cell = 0;
+        }
+
+        if ( page == nullptr )
+        {
+            atlas->statistics.rejections++;
+            return false;
+        }
+    }
+
+    atlas->contextWatcher.watch( const_cast< QSGRenderContext* >( atlasKey.context ) );
+
+    auto entry = new Entry { atlasKey, page, cell, 1, ++atlas->serial };
+
+    page->cells[ cell ] = entry;
+    page->storedCount++;
+    page->usedCount++;
+
+    atlas->keyMap[ atlasKey ] = entry;
+
+    {
+        const auto pos = page->cellPos( cell );
+
+        QPainter painter( &page->image );
+        painter.setCompositionMode( QPainter::CompositionMode_Source );
+
+        painter.fillRect( pos.x(), pos.y(),
+            page->extent(), page->extent(), Qt::transparent );
+
+        painter.drawImage( pos + QPoint( padding, padding ), image );
+    }
+
+    // the whole page is uploaded again
+    static_cast< QSGPlainTexture* >( page->texture )->setImage( page->image );
+
+    slot = qskSlot( entry );
+    return true;
+}
+
+bool QskTextureAtlas::releaseSlot( const QSGTexture* texture, const QRectF& rect )
+{
+    auto atlas = qskAtlas();
+
+    QMutexLocker locker( &atlas->mutex );
+
+    auto it = atlas->textureMap.find( texture );
+    if ( it == atlas->textureMap.end() )
+        return false;
+
+    auto page = it->second;
+
+    const int cell = page->cellAt( rect.topLeft() );
+    if ( cell < 0 || cell >= static_cast< int >( page->cells.size() ) )
+        return true;
+
+    auto entry = page->cells[ cell ];
+    if ( entry == nullptr || entry->refCount == 0 )
+        return true;
+
+    if ( --entry->refCount == 0 )
+    {
+        page->usedCount--;
+
+        if ( page->context == nullptr )
+        {
+            // the context is gone
+            qskRemoveEntry( atlas, entry );
+
+            if ( page->usedCount == 0 )
+                qskDeletePage( atlas, page );
+        }
+    }
+
+    return true;
+}
+
+void QskTextureAtlas::setMaxPages( int maxPages )
+{
+    auto atlas = qskAtlas();
+
+    QMutexLocker locker( &atlas->mutex );
+    atlas->maxPages = qMax( maxPages, 0 );
+}
+
+int QskTextureAtlas::maxPages()
+{
+    auto atlas = qskAtlas();
+
+    QMutexLocker locker( &atlas->mutex );
+    return atlas->maxPages;
+}
+
+QskTextureAtlas::Statistics QskTextureAtlas::statistics()
+{
+    auto atlas = qskAtlas();
+
+    QMutexLocker locker( &atlas->mutex );
+
+    auto statistics = atlas->statistics;
+
+    statistics.pageCount = static_cast< int >( atlas->pages.size() );
+
+    for ( const auto page : atlas->pages )
+    {
+        statistics.cellCount += static_cast< int >( page->cells.size() );
+        statistics.usedCells += page->usedCount;
+        statistics.unusedCells += page->storedCount - page->usedCount;
+    }
+
+    return statistics;
+}
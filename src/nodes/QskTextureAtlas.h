@@ -0,0 +1,73 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_TEXTURE_ATLAS_H
+#define QSK_TEXTURE_ATLAS_H
+
+#include "QskTextureCache.h"
+#include <qrect.h>
+
+class QImage;
+
+/*
+    Small images - like icons or symbols - are stored in cells of
+    shared texture pages, so that the scene graph renderer is able
+    to merge the nodes displaying them into a few batches.
+
+    Each page is divided into cells of the same size, that are
+    refcounted like the textures of QskTextureCache. Unused cells
+    are kept until a cell is needed and no page can be added anymore.
+ */
+namespace QskTextureAtlas
+{
+    class Slot
+    {
+      public:
+        QSGTexture* texture = nullptr;
+
+        // the rectangle inside of the texture in pixels
+        QRectF rect;
+    };
+
+    class Statistics
+    {
+      public:
+        inline qreal occupancy() const
+        {
+            return cellCount ? qreal( usedCells + unusedCells ) / cellCount : 0.0;
+        }
+
+        int pageCount = 0;
+
+        int cellCount = 0;
+        int usedCells = 0;
+        int unusedCells = 0;
+
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 evictions = 0;
+        quint64 rejections = 0;
+    };
+
+    // images up to this size in pixels can be stored
+    bool isAtlasSize( const QSize& );
+
+    // returns false, when the key is unknown
+    bool acquireSlot( const QQuickWindow*, const QskTextureCache::Key&, Slot& );
+
+    // returns false, when there is no space left for the image
+    bool insertSlot( QQuickWindow*, const QskTextureCache::Key&,
+        const QImage&, Slot& );
+
+    // returns false, when the texture is not a page of the atlas
+    bool releaseSlot( const QSGTexture*, const QRectF& );
+
+    QSK_EXPORT void setMaxPages( int );
+    QSK_EXPORT int maxPages();
+
+    QSK_EXPORT Statistics statistics();
+}
+
+#endif
@@ -0,0 +1,272 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskTextureCache.h"
+#include "QskRenderContextWatcher.h"
+
+#include <qmutex.h>
+#include <qquickwindow.h>
+#include <qsgtexture.h>
+
+QSK_QT_PRIVATE_BEGIN
+#include <private/qquickwindow_p.h>
+#include <private/qsgcontext_p.h>
+QSK_QT_PRIVATE_END
+
+#include <list>
+#include <unordered_map>
+
+static void qskPurgeContext( const QSGRenderContext* );
+
+namespace
+{
+    class CacheKey
+    {
+      public:
+        inline bool operator==( const CacheKey& other ) const
+        {
+            return ( context == other.context ) && ( type == other.type )
+                && ( hash == other.hash ) && ( size == other.size );
+        }
+
+        const QSGRenderContext* context;
+        size_t type;
+        QskHashValue hash;
+        QSize size;
+    };
+
+    class CacheKeyHash
+    {
+      public:
+        inline size_t operator()( const CacheKey& key ) const
+        {
+            auto value = qHash( key.context, key.hash );
+            value = qHash( key.type, value );
+            value = qHash( key.size.width(), value );
+            value = qHash( key.size.height(), value );
+
+            return value;
+        }
+    };
+
+    class Entry
+    {
+      public:
+        CacheKey key;
+        QSGTexture* texture;
+
+        int refCount;
+        qint64 bytes;
+    };
+
+    using EntryList = std::list< Entry >;
+
+    class Cache
+    {
+      public:
+        QMutex mutex;
+
+        // the most recently used entries are at the front
+        EntryList entries;
+
+        std::unordered_map< CacheKey, EntryList::iterator, CacheKeyHash > keyMap;
+        std::unordered_map< const QSGTexture*, EntryList::iterator > textureMap;
+
+        QskRenderContextWatcher contextWatcher { qskPurgeContext };
+
+        qint64 maxBytes = 32 * 1024 * 1024;
+
+        QskTextureCache::Statistics statistics;
+    };
+}
+
+Q_GLOBAL_STATIC( Cache, qskCache )
+
+static inline QSGRenderContext* qskRenderContext( const QQuickWindow* window )
+{
+    auto w = const_cast< QQuickWindow* >( window );
+    return QQuickWindowPrivate::get( w )->context;
+}
+
+static inline CacheKey qskCacheKey(
+    const QQuickWindow* window, const QskTextureCache::Key& key )
+{
+    return { qskRenderContext( window ), key.type, key.hash, key.size };
+}
+
+static void qskRemoveEntry( Cache* cache, EntryList::iterator it, bool deleteTexture )
+{
+    auto& statistics = cache->statistics;
+
+    statistics.textureCount--;
+    statistics.bytes -= it->bytes;
+
+    if ( it->refCount == 0 )
+        statistics.unusedCount--;
+
+    cache->keyMap.erase( it->key );
+    cache->textureMap.erase( it->texture );
+
+    if ( deleteTexture )
+        delete it->texture;
+
+    cache->entries.erase( it );
+}
+
+static void qskEvict( Cache* cache, const QSGRenderContext* context )
+{
+    /*
+        Textures have to be deleted in the thread of their
+        render context. So we only evict textures of the context,
+        that is in use by the calling thread.
+     */
+
+    auto it = cache->entries.end();
+    while ( ( cache->statistics.bytes > cache->maxBytes )
+        && ( it != cache->entries.begin() ) )
+    {
+        --it;
+
+        if ( it->refCount == 0 && it->key.context == context )
+        {
+            auto next = std::next( it );
+            qskRemoveEntry( cache, it, true );
+            cache->statistics.evictions++;
+
+            it = next;
+        }
+    }
+}
+
+static void qskPurgeContext( const QSGRenderContext* context )
+{
+    auto cache = qskCache();
+
+    QMutexLocker locker( &cache->mutex );
+
+    auto it = cache->entries.begin();
+    while ( it != cache->entries.end() )
+    {
+        auto next = std::next( it );
+
+        if ( it->key.context == context )
+        {
+            /*
+                Textures in use are only forgotten and will be deleted
+                by the nodes, when releasing them.
+             */
+            qskRemoveEntry( cache, it, it->refCount == 0 );
+        }
+
+        it = next;
+    }
+
+    cache->contextWatcher.forget( context );
+}
+
+QSGTexture* QskTextureCache::acquireTexture(
+    const QQuickWindow* window, const Key& key )
+{
+    auto cache = qskCache();
+
+    QMutexLocker locker( &cache->mutex );
+
+    auto it = cache->keyMap.find( qskCacheKey( window, key ) );
+    if ( it == cache->keyMap.end() )
+    {
+        cache->statistics.misses++;
+        return nullptr;
+    }
+
+    auto entry = it->second;
+
+    if ( entry->refCount++ == 0 )
+        cache->statistics.unusedCount--;
+
+    cache->entries.splice( cache->entries.begin(), cache->entries, entry );
+    cache->statistics.hits++;
+
+    return entry->texture;
+}
+
+void QskTextureCache::insertTexture(
+    const QQuickWindow* window, const Key& key, QSGTexture* texture )
+{
+    if ( texture == nullptr )
+        return;
+
+    auto cache = qskCache();
+
+    QMutexLocker locker( &cache->mutex );
+
+    const auto cacheKey = qskCacheKey( window, key );
+
+    if ( cache->keyMap.count( cacheKey ) || cache->textureMap.count( texture ) )
+    {
+        qWarning( "QskTextureCache: texture has already been inserted" );
+        return;
+    }
+
+    cache->contextWatcher.watch( const_cast< QSGRenderContext* >( cacheKey.context ) );
+
+    const auto textureSize = texture->textureSize();
+    const auto bytes = qint64( textureSize.width() ) * textureSize.height() * 4;
+
+    cache->entries.push_front( { cacheKey, texture, 1, bytes } );
+
+    const auto it = cache->entries.begin();
+    cache->keyMap[ cacheKey ] = it;
+    cache->textureMap[ texture ] = it;
+
+    cache->statistics.textureCount++;
+    cache->statistics.bytes += bytes;
+
+    qskEvict( cache, cacheKey.context );
+}
+
+bool QskTextureCache::releaseTexture( const QSGTexture* texture )
+{
+    auto cache = qskCache();
+
+    QMutexLocker locker( &cache->mutex );
+
+    auto it = cache->textureMap.find( texture );
+    if ( it == cache->textureMap.end() )
+        return false;
+
+    auto entry = it->second;
+
+    if ( --entry->refCount == 0 )
+    {
+        cache->statistics.unusedCount++;
+        qskEvict( cache, entry->key.context );
+    }
+
+    return true;
+}
+
+void QskTextureCache::setMaxBytes( qint64 maxBytes )
+{
+    auto cache = qskCache();
+
+    QMutexLocker locker( &cache->mutex );
+    cache->maxBytes = qMax( maxBytes, qint64( 0 ) );
+}
+
+qint64 QskTextureCache::maxBytes()
+{
+    auto cache = qskCache();
+
+    QMutexLocker locker( &cache->mutex );
+    return cache->maxBytes;
+}
+
+QskTextureCache::Statistics QskTextureCache::statistics()
+{
+    auto cache = qskCache();
+
+    QMutexLocker locker( &cache->mutex );
+    return cache->statistics;
+}
@@ -0,0 +1,64 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_TEXTURE_CACHE_H
+#define QSK_TEXTURE_CACHE_H
+
+#include "QskGlobal.h"
+#include <qsize.h>
+
+class QSGTexture;
+class QQuickWindow;
+
+/*
+    A process wide cache of textures, that can be shared between
+    nodes painting the same content. The textures are identified
+    by the content hash of the node, the size in pixels and the
+    render context they have been created for.
+
+    Textures, that are not in use anymore, are kept until the budget
+    is exceeded and then deleted in LRU order. As textures have to be
+    deleted in the thread of their render context, only textures of
+    the context that is currently in use are evicted.
+ */
+namespace QskTextureCache
+{
+    class Key
+    {
+      public:
+        size_t type;        // the type of the node, f.e typeid().hash_code()
+        QskHashValue hash;  // content hash of the node
+        QSize size;         // size in pixels
+    };
+
+    class Statistics
+    {
+      public:
+        int textureCount = 0;
+        int unusedCount = 0;
+
+        qint64 bytes = 0;
+
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 evictions = 0;
+    };
+
+    // returns a texture with an increased reference count or nullptr
+    QSGTexture* acquireTexture( const QQuickWindow*, const Key& );
+
+    // inserts a texture with a reference count of 1
+    void insertTexture( const QQuickWindow*, const Key&, QSGTexture* );
+
+    // decreases the reference count, returns false for unknown textures
+    bool releaseTexture( const QSGTexture* );
+
+    QSK_EXPORT void setMaxBytes( qint64 );
+    QSK_EXPORT qint64 maxBytes();
+
+    QSK_EXPORT Statistics statistics();
+}
+
+#endif
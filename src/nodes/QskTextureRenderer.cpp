@@ -6,17 +6,19 @@
 #include "QskTextureRenderer.h"
 
 #include <qopenglcontext.h>
+#include <qopenglextrafunctions.h>
 #include <qopenglframebufferobject.h>
 #include <qopenglpaintdevice.h>
 
 #include <qimage.h>
 #include <qpainter.h>
+#include <qmutex.h>
+#include <qhash.h>
 
 #include <qquickwindow.h>
 
 QSK_QT_PRIVATE_BEGIN
 #include <private/qsgplaintexture_p.h>
-#include <private/qopenglframebufferobject_p.h>
 #include <private/qquickwindow_p.h>
 QSK_QT_PRIVATE_END
 
@@ -24,99 +26,305 @@ QSK_QT_PRIVATE_END
     #include <qquickopenglutils.h>
 #endif
 
-static GLuint qskTakeTexture( QOpenGLFramebufferObject& fbo )
+#include <vector>
+#include <atomic>
+
+#ifndef GL_RGBA8
+    #define GL_RGBA8 0x8058
+#endif
+
+#ifndef GL_READ_FRAMEBUFFER
+    #define GL_READ_FRAMEBUFFER 0x8CA8
+#endif
+
+#ifndef GL_DRAW_FRAMEBUFFER
+    #define GL_DRAW_FRAMEBUFFER 0x8CA9
+#endif
+
+namespace
 {
     /*
-        See https://bugreports.qt.io/browse/QTBUG-103929
+        Painting with the OpenGL paint engine needs a multisampled FBO
+        with a depth/stencil attachment, that is finally resolved into
+        the texture. Allocating those objects for each update of a node
+        is expensive - especially when animating.
 
-        As we create a FBO for each update of a node we can't live
-        without having this ( ugly ) workaround.
+        So each OpenGL context has a pool of FBOs, that are bucketed
+        by size, and a pool of textures, that are waiting to be reused.
      */
-    class MyFBO
+
+    inline QSize bucketSize( const QSize& size )
+    {
+        const int step = 64;
+
+        return QSize( ( size.width() + step - 1 ) / step * step,
+            ( size.height() + step - 1 ) / step * step );
+    }
+
+    inline quint64 sizeKey( const QSize& size )
+    {
+        return ( quint64( size.width() ) << 32 ) | quint32( size.height() );
+    }
+
+    class FboPool
     {
       public:
-        virtual ~MyFBO() = default;
-        QScopedPointer< QOpenGLFramebufferObjectPrivate > d_ptr;
-    };
+        FboPool( QOpenGLContext* context )
+            : m_context( context )
+        {
+        }
 
-    static_assert( sizeof( MyFBO ) == sizeof( QOpenGLFramebufferObject ),
-        "Bad cast: QOpenGLFramebufferObject does not match" );
+        ~FboPool()
+        {
+            // resources can only be released, when the context is current
+            if ( QOpenGLContext::currentContext() != m_context )
+                return;
 
-    auto& attachment = reinterpret_cast< MyFBO* >( &fbo )->d_ptr->colorAttachments[0];
-    auto guard = attachment.guard;
+            for ( const auto& fbo : m_fbos )
+                delete fbo.fbo;
 
-    const auto textureId = fbo.takeTexture();
+            auto f = m_context->functions();
 
-    if ( guard )
-    {
-        class MyGuard : public QOpenGLSharedResourceGuard
+            for ( auto it = m_textures.constBegin(); it != m_textures.constEnd(); ++it )
+            {
+                const GLuint textureId = it.value();
+                f->glDeleteTextures( 1, &textureId );
+            }
+
+            if ( m_resolveFbo )
+                f->glDeleteFramebuffers( 1, &m_resolveFbo );
+        }
+
+        QOpenGLFramebufferObject* multisampledFbo(
+            const QSize& size, int samples, bool& reused )
+        {
+            const auto fboSize = bucketSize( size );
+
+            m_serial++;
+
+            for ( auto& fbo : m_fbos )
+            {
+                if ( fbo.samples == samples && fbo.fbo->size() == fboSize )
+                {
+                    fbo.lastUse = m_serial;
+
+                    reused = true;
+                    return fbo.fbo;
+                }
+            }
+
+            if ( m_fbos.size() >= maxFbos )
+            {
+                auto lru = m_fbos.begin();
+                for ( auto it = m_fbos.begin(); it != m_fbos.end(); ++it )
+                {
+                    if ( it->lastUse < lru->lastUse )
+                        lru = it;
+                }
+
+                delete lru->fbo;
+                m_fbos.erase( lru );
+            }
+
+            QOpenGLFramebufferObjectFormat format;
+            format.setAttachment( QOpenGLFramebufferObject::CombinedDepthStencil );
+            format.setSamples( samples );
+
+            m_fbos.push_back( { new QOpenGLFramebufferObject( fboSize, format ),
+                samples, m_serial } );
+
+            m_fboCount = static_cast< int >( m_fbos.size() );
+
+            reused = false;
+            return m_fbos.back().fbo;
+        }
+
+        GLuint resolveFbo()
+        {
+            if ( m_resolveFbo == 0 )
+                m_context->functions()->glGenFramebuffers( 1, &m_resolveFbo );
+
+            return m_resolveFbo;
+        }
+
+        GLuint takeTexture( const QSize& size )
+        {
+            auto it = m_textures.find( sizeKey( size ) );
+            if ( it == m_textures.end() )
+                return 0;
+
+            const auto textureId = it.value();
+            m_textures.erase( it );
+
+            m_textureCount = m_textures.size();
+
+            return textureId;
+        }
+
+        void recycleTexture( GLuint textureId, const QSize& size )
+        {
+            if ( m_textures.size() < maxTextures )
+            {
+                m_textures.insert( sizeKey( size ), textureId );
+                m_textureCount = m_textures.size();
+            }
+            else
+            {
+                m_context->functions()->glDeleteTextures( 1, &textureId );
+            }
+        }
+
+        GLuint createTexture( const QSize& size )
+        {
+            auto f = m_context->functions();
+
+            const GLint format = m_context->isOpenGLES() ? GL_RGBA : GL_RGBA8;
+
+            GLuint textureId;
+            f->glGenTextures( 1, &textureId );
+
+            f->glBindTexture( GL_TEXTURE_2D, textureId );
+
+            f->glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR );
+            f->glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
+            f->glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
+            f->glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+
+            f->glTexImage2D( GL_TEXTURE_2D, 0, format, size.width(), size.height(),
+                0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr );
+
+            f->glBindTexture( GL_TEXTURE_2D, 0 );
+
+            return textureId;
+        }
+
+        // the counters might be read from other threads
+        int fboCount() const { return m_fboCount; }
+        int textureCount() const { return m_textureCount; }
+
+      private:
+        const size_t maxFbos = 8;
+        const int maxTextures = 32;
+
+        class Fbo
         {
           public:
-            void invalidateTexture() { invalidateResource(); }
+            QOpenGLFramebufferObject* fbo;
+            int samples;
+            quint64 lastUse;
         };
 
-        reinterpret_cast< MyGuard* >( guard )->invalidateTexture();
-    }
+        QOpenGLContext* m_context;
 
-    attachment.guard = guard;
+        std::vector< Fbo > m_fbos;
+        QMultiHash< quint64, GLuint > m_textures;
 
-    return textureId;
-}
+        GLuint m_resolveFbo = 0;
+        quint64 m_serial = 0;
 
-bool QskTextureRenderer::isOpenGLWindow( const QQuickWindow* window )
-{
-    if ( window == nullptr )
-        return false;
+        std::atomic< int > m_fboCount { 0 };
+        std::atomic< int > m_textureCount { 0 };
+    };
 
-    const auto renderer = window->rendererInterface();
-    switch( renderer->graphicsApi() )
+    class PoolRegistry
     {
-        case QSGRendererInterface::OpenGL:
-#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
-        case QSGRendererInterface::OpenGLRhi:
-#endif
-            return true;
+      public:
+        QMutex mutex;
 
-        default:
-            return false;
-    }
+        QHash< const QOpenGLContext*, FboPool* > pools;
+        QskTextureRenderer::PoolStatistics statistics;
+    };
+
+    class PooledTexture final : public QSGPlainTexture
+    {
+      public:
+        PooledTexture( QQuickWindow* window, GLuint textureId, const QSize& size )
+        {
+            setHasAlphaChannel( true );
+
+            /*
+                Without RHI the plain texture would delete the texture id,
+                otherwise it owns the wrapper around the native texture only.
+             */
+            setOwnsTexture( QQuickWindowPrivate::get( window )->rhi != nullptr );
+
+            setPooledTextureId( window, textureId, size );
+        }
+
+        ~PooledTexture() override
+        {
+            QskTextureRenderer::recycleTextureGL( m_textureId, m_size );
+        }
+
+        void setPooledTextureId( QQuickWindow* window, GLuint textureId, const QSize& size )
+        {
+            if ( m_textureId == textureId && m_size == size )
+                return;
+
+            const auto oldTextureId = m_textureId;
+            const auto oldSize = m_size;
+
+            m_textureId = textureId;
+            m_size = size;
+
+            QskTextureRenderer::setTextureId( window, textureId, size, this );
+
+            if ( oldTextureId && oldTextureId != textureId )
+                QskTextureRenderer::recycleTextureGL( oldTextureId, oldSize );
+        }
+
+        inline GLuint pooledTextureId() const { return m_textureId; }
+
+      private:
+        GLuint m_textureId = 0;
+        QSize m_size;
+    };
 }
 
-void QskTextureRenderer::setTextureId( QQuickWindow* window,
-    quint32 textureId, const QSize& size, QSGTexture* texture )
+Q_GLOBAL_STATIC( PoolRegistry, qskPoolRegistry )
+
+static FboPool* qskFboPool( QOpenGLContext* context )
 {
-    auto plainTexture = qobject_cast< QSGPlainTexture* >( texture );
-    if ( plainTexture == nullptr )
-        return;
+    auto registry = qskPoolRegistry();
 
-    auto rhi = QQuickWindowPrivate::get( window )->rhi;
+    QMutexLocker locker( &registry->mutex );
 
-#if QT_VERSION >= QT_VERSION_CHECK( 6, 4, 0 )
+    auto& pool = registry->pools[ context ];
+    if ( pool == nullptr )
+    {
+        pool = new FboPool( context );
 
-    const uint nativeFormat = 0;
-    plainTexture->setTextureFromNativeTexture(
-        rhi, quint64( textureId ), 0, nativeFormat, size, {}, {} );
+        QObject::connect( context, &QOpenGLContext::aboutToBeDestroyed,
+            context, [ context ]
+            {
+                auto registry = qskPoolRegistry();
 
-#elif QT_VERSION >= QT_VERSION_CHECK( 6, 0, 0 )
-    plainTexture->setTextureFromNativeTexture(
-        rhi, quint64( textureId ), 0, size, {}, {} );
-#else
-    if ( rhi )
-    {
-        // enabled with: "export QSG_RHI=1"
-        plainTexture->setTextureFromNativeObject( rhi,
-            QQuickWindow::NativeObjectTexture, &textureId, 0, size, false );
-    }
-    else
-    {
-        plainTexture->setTextureId( textureId );
-        plainTexture->setTextureSize( size );
+                FboPool* pool;
+
+                {
+                    QMutexLocker locker( &registry->mutex );
+                    pool = registry->pools.take( context );
+                }
+
+                delete pool;
+            },
+            Qt::DirectConnection );
     }
-#endif
+
+    return pool;
 }
 
-quint32 QskTextureRenderer::createPaintedTextureGL(
-    QQuickWindow* window, const QSize& size, QskTextureRenderer::PaintHelper* helper )
+template< typename Function >
+static inline void qskUpdateStatistics( Function function )
+{
+    auto registry = qskPoolRegistry();
+
+    QMutexLocker locker( &registry->mutex );
+    function( registry->statistics );
+}
+
+static void qskPaintTextureGL( QQuickWindow* window, FboPool* pool,
+    GLuint textureId, const QSize& size, QskTextureRenderer::PaintHelper* helper )
 {
     /*
         Binding GL_ARRAY_BUFFER/GL_ELEMENT_ARRAY_BUFFER to 0 seems to be enough.
@@ -143,12 +351,30 @@ quint32 QskTextureRenderer::createPaintedTextureGL(
 
     auto context = QOpenGLContext::currentContext();
 
-    QOpenGLFramebufferObjectFormat format1;
-    format1.setAttachment( QOpenGLFramebufferObject::CombinedDepthStencil );
+    /*
+        Without glBlitFramebuffer ( f.e. OpenGL ES 2.0 ) we can't resolve
+        a multisampled FBO and have to paint to a single sampled one,
+        that is copied to the texture instead.
+     */
+    const bool canBlit = QOpenGLFramebufferObject::hasOpenGLFramebufferBlit();
+    const int samples = canBlit ? context->format().samples() : 0;
 
-    format1.setSamples( context->format().samples() );
+    bool reused;
+    auto multisampledFbo = pool->multisampledFbo( size, samples, reused );
 
-    QOpenGLFramebufferObject multisampledFbo( size, format1 );
+    qskUpdateStatistics( [ reused ]( QskTextureRenderer::PoolStatistics& statistics )
+    {
+        if ( reused )
+            statistics.fboReuses++;
+        else
+            statistics.fboAllocations++;
+    } );
+
+    /*
+        The FBO might be larger than the texture, but the viewport
+        of the paint device is limited to the size of the texture.
+     */
+    multisampledFbo->bind();
 
     QOpenGLPaintDevice pd( size );
     pd.setPaintFlipped( true );
@@ -166,7 +392,7 @@ quint32 QskTextureRenderer::createPaintedTextureGL(
         helper->paint( &painter, size / ratio );
 
 #if 1
-        if ( format1.samples() > 0 )
+        if ( samples > 0 )
         {
             /*
                 Multisampling in the window surface might get lost
@@ -178,19 +404,153 @@ quint32 QskTextureRenderer::createPaintedTextureGL(
 #endif
     }
 
-    QOpenGLFramebufferObjectFormat format2;
-    format2.setAttachment( QOpenGLFramebufferObject::NoAttachment );
+    if ( canBlit )
+    {
+        auto f = context->extraFunctions();
+
+        f->glBindFramebuffer( GL_READ_FRAMEBUFFER, multisampledFbo->handle() );
+        f->glBindFramebuffer( GL_DRAW_FRAMEBUFFER, pool->resolveFbo() );
 
-    QOpenGLFramebufferObject fbo( size, format2 );
+        f->glFramebufferTexture2D( GL_DRAW_FRAMEBUFFER,
+            GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, textureId, 0 );
 
-    const QRect fboRect( 0, 0, size.width(), size.height() );
+        f->glBlitFramebuffer( 0, 0, size.width(), size.height(),
+            0, 0, size.width(), size.height(), GL_COLOR_BUFFER_BIT, GL_NEAREST );
 
-    QOpenGLFramebufferObject::blitFramebuffer(
-        &fbo, fboRect, &multisampledFbo, fboRect );
+        f->glFramebufferTexture2D( GL_DRAW_FRAMEBUFFER,
+            GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0 );
+    }
+    else
+    {
+        auto f = context->functions();
+
+        f->glBindFramebuffer( GL_FRAMEBUFFER, multisampledFbo->handle() );
+
+        f->glBindTexture( GL_TEXTURE_2D, textureId );
+        f->glCopyTexSubImage2D( GL_TEXTURE_2D, 0,
+            0, 0, 0, 0, size.width(), size.height() );
+        f->glBindTexture( GL_TEXTURE_2D, 0 );
+    }
+
+    context->functions()->glBindFramebuffer(
+        GL_FRAMEBUFFER, context->defaultFramebufferObject() );
 
     window->endExternalCommands();
+}
+
+bool QskTextureRenderer::isOpenGLWindow( const QQuickWindow* window )
+{
+    if ( window == nullptr )
+        return false;
+
+    const auto renderer = window->rendererInterface();
+    switch( renderer->graphicsApi() )
+    {
+        case QSGRendererInterface::OpenGL:
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+        case QSGRendererInterface::OpenGLRhi:
+#endif
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+void QskTextureRenderer::setTextureId( QQuickWindow* window,
+    quint32 textureId, const QSize& size, QSGTexture* texture )
+{
+    auto plainTexture = qobject_cast< QSGPlainTexture* >( texture );
+    if ( plainTexture == nullptr )
+        return;
+
+    auto rhi = QQuickWindowPrivate::get( window )->rhi;
+
+#if QT_VERSION >= QT_VERSION_CHECK( 6, 4, 0 )
+
+    const uint nativeFormat = 0;
+    plainTexture->setTextureFromNativeTexture(
+        rhi, quint64( textureId ), 0, nativeFormat, size, {}, {} );
+
+#elif QT_VERSION >= QT_VERSION_CHECK( 6, 0, 0 )
+    plainTexture->setTextureFromNativeTexture(
+        rhi, quint64( textureId ), 0, size, {}, {} );
+#else
+    if ( rhi )
+    {
+        // enabled with: "export QSG_RHI=1"
+        plainTexture->setTextureFromNativeObject( rhi,
+            QQuickWindow::NativeObjectTexture, &textureId, 0, size, false );
+    }
+    else
+    {
+        plainTexture->setTextureId( textureId );
+        plainTexture->setTextureSize( size );
+    }
+#endif
+}
+
+quint32 QskTextureRenderer::createPaintedTextureGL(
+    QQuickWindow* window, const QSize& size, QskTextureRenderer::PaintHelper* helper )
+{
+    auto context = QOpenGLContext::currentContext();
+    auto pool = qskFboPool( context );
+
+    auto textureId = pool->takeTexture( size );
+
+    const bool reused = ( textureId != 0 );
+    if ( !reused )
+        textureId = pool->createTexture( size );
+
+    qskUpdateStatistics( [ reused ]( PoolStatistics& statistics )
+    {
+        if ( reused )
+            statistics.textureReuses++;
+        else
+            statistics.textureAllocations++;
+    } );
+
+    qskPaintTextureGL( window, pool, textureId, size, helper );
+
+    return textureId;
+}
+
+void QskTextureRenderer::repaintTextureGL( QQuickWindow* window,
+    quint32 textureId, const QSize& size, QskTextureRenderer::PaintHelper* helper )
+{
+    auto pool = qskFboPool( QOpenGLContext::currentContext() );
+
+    qskUpdateStatistics( []( PoolStatistics& statistics )
+        { statistics.textureRepaints++; } );
+
+    qskPaintTextureGL( window, pool, textureId, size, helper );
+}
+
+void QskTextureRenderer::recycleTextureGL( quint32 textureId, const QSize& size )
+{
+    if ( textureId == 0 )
+        return;
+
+    /*
+        When there is no context we can't do anything: the texture
+        is gone with the context anyway.
+     */
+    if ( auto context = QOpenGLContext::currentContext() )
+        qskFboPool( context )->recycleTexture( textureId, size );
+}
 
-    return qskTakeTexture( fbo );
+QSGTexture* QskTextureRenderer::createTextureGL(
+    QQuickWindow* window, quint32 textureId, const QSize& size )
+{
+    return new PooledTexture( window, textureId, size );
+}
+
+quint32 QskTextureRenderer::textureIdGL( const QSGTexture* texture )
+{
+    if ( auto pooledTexture = dynamic_cast< const PooledTexture* >( texture ) )
+        return pooledTexture->pooledTextureId();
+
+    return 0;
 }
 
 static QSGTexture* qskCreateTextureRaster( QQuickWindow* window,
@@ -222,17 +582,29 @@ QSGTexture* QskTextureRenderer::createPaintedTexture(
     if ( isOpenGLWindow( window ) )
     {
         const auto textureId = createPaintedTextureGL( window, size, helper );
-
-        auto texture = new QSGPlainTexture;
-        texture->setHasAlphaChannel( true );
-        texture->setOwnsTexture( true );
-
-        setTextureId( window, textureId, size, texture );
-
-        return texture;
+        return createTextureGL( window, textureId, size );
     }
     else
     {
         return qskCreateTextureRaster( window, size, helper );
     }
 }
+
+QskTextureRenderer::PoolStatistics QskTextureRenderer::poolStatistics()
+{
+    auto registry = qskPoolRegistry();
+
+    QMutexLocker locker( &registry->mutex );
+
+    auto statistics = registry->statistics;
+
+    statistics.pooledFbos = statistics.pooledTextures = 0;
+
+    for ( auto pool : qAsConst( registry->pools ) )
+    {
+        statistics.pooledFbos += pool->fboCount();
+        statistics.pooledTextures += pool->textureCount();
+    }
+
+    return statistics;
+}
@@ -27,16 +27,57 @@ namespace QskTextureRenderer
         Q_DISABLE_COPY( PaintHelper )
     };
 
+    class PoolStatistics
+    {
+      public:
+        inline quint64 allocationsAvoided() const
+        {
+            return fboReuses + textureReuses + textureRepaints;
+        }
+
+        quint64 fboAllocations = 0;
+        quint64 fboReuses = 0;
+
+        quint64 textureAllocations = 0;
+        quint64 textureReuses = 0;
+        quint64 textureRepaints = 0;
+
+        int pooledFbos = 0;
+        int pooledTextures = 0;
+    };
+
     bool isOpenGLWindow( const QQuickWindow* );
 
     void setTextureId( QQuickWindow*,
         quint32 textureId, const QSize&, QSGTexture* );
 
+    /*
+        The framebuffer objects, that are needed for painting, and the
+        textures are taken from a pool of the current OpenGL context.
+        Texture ids, that are not needed anymore, have to be given
+        back by recycleTextureGL.
+     */
     quint32 createPaintedTextureGL(
         QQuickWindow*, const QSize&, QskTextureRenderer::PaintHelper* );
 
+    // painting into an existing texture without any allocations
+    void repaintTextureGL( QQuickWindow*,
+        quint32 textureId, const QSize&, QskTextureRenderer::PaintHelper* );
+
+    void recycleTextureGL( quint32 textureId, const QSize& );
+
+    /*
+        A texture for a texture id from createPaintedTextureGL, that gives
+        the id back to the pool, when being deleted. textureIdGL returns
+        the id of such a texture or 0 for any other texture.
+     */
+    QSGTexture* createTextureGL( QQuickWindow*, quint32 textureId, const QSize& );
+    quint32 textureIdGL( const QSGTexture* );
+
     QSK_EXPORT QSGTexture* createPaintedTexture(
         QQuickWindow* window, const QSize& size, PaintHelper* helper );
+
+    QSK_EXPORT PoolStatistics poolStatistics();
 }
 
 #endif
@@ -0,0 +1,290 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskVectorGraphicNode.h"
+#include "QskGraphic.h"
+#include "QskColorFilter.h"
+#include "QskGradient.h"
+#include "QskPainterCommand.h"
+#include "QskShapeNode.h"
+#include "QskStrokeNode.h"
+#include "QskSGNode.h"
+
+#include <qmath.h>
+#include <qtransform.h>
+
+namespace
+{
+    enum Role : quint8
+    {
+        FillRole,
+        StrokeRole
+    };
+}
+
+static inline bool qskIsVisible( const QBrush& brush )
+{
+    return ( brush.style() != Qt::NoBrush ) && ( brush.color().alpha() > 0 );
+}
+
+static inline bool qskIsVisible( const QPen& pen )
+{
+    return ( pen.style() != Qt::NoPen ) && qskIsVisible( pen.brush() );
+}
+
+static inline bool qskIsSupported( const QBrush& brush )
+{
+    return ( brush.style() == Qt::NoBrush ) || ( brush.style() == Qt::SolidPattern );
+}
+
+static inline qreal qskTessellationScale( qreal sx, qreal sy )
+{
+    /*
+        Tessellating curves in the small coordinate system of a graphic
+        and scaling them up afterwards results in visible edges. So we
+        tessellate in a coordinate system, that is scaled by a power of 2.
+     */
+    const auto scale = qMax( qAbs( sx ), qAbs( sy ) );
+    return std::exp2( std::ceil( std::log2( qMax( scale, 1e-3 ) ) ) );
+}
+
+static QskHashValue qskGraphicHash(
+    const QskGraphic& graphic, const QskColorFilter& colorFilter )
+{
+    QskHashValue hash = 12001;
+
+    const auto& substitutions = colorFilter.substitutions();
+    if ( substitutions.size() > 0 )
+    {
+        hash = qHashBits( substitutions.constData(),
+            substitutions.size() * sizeof( substitutions[ 0 ] ), hash );
+    }
+
+    return graphic.hash( hash );
+}
+
+template< typename Node >
+static Node* qskNextNode( QSGNode* parentNode, QSGNode*& node, quint8 role )
+{
+    if ( node && QskSGNode::nodeRole( node ) == role )
+    {
+        auto n = static_cast< Node* >( node );
+        node = node->nextSibling();
+
+        return n;
+    }
+
+    auto newNode = QskSGNode::createNode< Node >( role );
+
+    if ( node )
+        parentNode->insertChildNodeBefore( newNode, node );
+    else
+        parentNode->appendChildNode( newNode );
+
+    return newNode;
+}
+
+QskVectorGraphicNode::QskVectorGraphicNode()
+    : m_hash( 0 )
+    , m_tessellationScale( 0.0 )
+    , m_supportHash( 0 )
+    , m_isSupported( false )
+    , m_mirrored( Qt::Orientations() )
+{
+}
+
+QskVectorGraphicNode::~QskVectorGraphicNode()
+{
+}
+
+bool QskVectorGraphicNode::isSupported( const QskGraphic& graphic )
+{
+    if ( graphic.commandTypes() & QskGraphic::RasterData )
+        return false;
+
+    if ( graphic.testRenderHint( QskGraphic::RenderPensUnscaled ) )
+        return false;
+
+    for ( const auto& command : graphic.commands() )
+    {
+        if ( command.type() != QskPainterCommand::State )
+            continue;
+
+        const auto data = command.stateData();
+        const auto flags = data->flags;
+
+        if ( flags & QPaintEngine::DirtyPen )
+        {
+            if ( data->pen.isCosmetic() || !qskIsSupported( data->pen.brush() ) )
+                return false;
+        }
+
+        if ( ( flags & QPaintEngine::DirtyBrush ) && !qskIsSupported( data->brush ) )
+            return false;
+
+        if ( ( flags & QPaintEngine::DirtyClipEnabled ) && data->isClipEnabled )
+            return false;
+
+        if ( flags & ( QPaintEngine::DirtyClipRegion | QPaintEngine::DirtyClipPath ) )
+        {
+            if ( data->clipOperation != Qt::NoClip )
+                return false;
+        }
+
+        if ( ( flags & QPaintEngine::DirtyCompositionMode )
+            && data->compositionMode != QPainter::CompositionMode_SourceOver )
+        {
+            return false;
+        }
+
+        if ( ( flags & QPaintEngine::DirtyOpacity ) && data->opacity < 1.0 )
+            return false;
+    }
+
+    return true;
+}
+
+bool QskVectorGraphicNode::canDisplay( const QskGraphic& graphic ) const
+{
+    // walking over all commands for each update is too expensive
+    const auto hash = graphic.hash( 0 );
+
+    if ( hash != m_supportHash || hash == 0 )
+    {
+        m_supportHash = hash;
+        m_isSupported = isSupported( graphic );
+    }
+
+    return m_isSupported;
+}
+
+void QskVectorGraphicNode::setMirrored( Qt::Orientations mirrored )
+{
+    m_mirrored = mirrored;
+}
+
+Qt::Orientations QskVectorGraphicNode::mirrored() const
+{
+    return m_mirrored;
+}
+
+void QskVectorGraphicNode::setGraphic( const QskGraphic& graphic,
+    const QskColorFilter& colorFilter, const QRectF& rect )
+{
+    const auto br = graphic.boundingRect();
+
+    if ( graphic.isEmpty() || rect.isEmpty() || br.isEmpty() )
+    {
+        m_hash = 0;
+        QskSGNode::removeAllChildNodesFrom( this, firstChild() );
+
+        return;
+    }
+
+    const qreal sx = rect.width() / br.width();
+    const qreal sy = rect.height() / br.height();
+
+    const auto tessellationScale = qskTessellationScale( sx, sy );
+    const auto hash = qskGraphicHash( graphic, colorFilter );
+
+    if ( hash != m_hash || tessellationScale != m_tessellationScale )
+    {
+        m_hash = hash;
+        m_tessellationScale = tessellationScale;
+
+        updateChildNodes( graphic, colorFilter );
+    }
+
+    /*
+        Mapping the bounding rectangle of the graphic into rect,
+        what corresponds to QskGraphic::render with Qt::IgnoreAspectRatio.
+     */
+    const auto rc = rect.center();
+
+    QTransform transform;
+    transform.translate( rc.x(), rc.y() );
+
+    if ( m_mirrored & Qt::Horizontal )
+        transform.scale( -1.0, 1.0 );
+
+    if ( m_mirrored & Qt::Vertical )
+        transform.scale( 1.0, -1.0 );
+
+    transform.translate( -0.5 * sx * br.width(), -0.5 * sy * br.height() );
+    transform.scale( sx, sy );
+    transform.translate( -br.x(), -br.y() );
+    transform.scale( 1.0 / tessellationScale, 1.0 / tessellationScale );
+
+    const QMatrix4x4 matrix( transform );
+    if ( matrix != this->matrix() )
+        setMatrix( matrix );
+}
+
+void QskVectorGraphicNode::updateChildNodes(
+    const QskGraphic& graphic, const QskColorFilter& colorFilter )
+{
+    const auto scale = QTransform::fromScale( m_tessellationScale, m_tessellationScale );
+
+    QPen pen;
+    QBrush brush;
+    QTransform transform;
+
+    auto node = firstChild();
+
+    for ( const auto& command : graphic.commands() )
+    {
+        if ( command.type() == QskPainterCommand::State )
+        {
+            const auto data = command.stateData();
+
+            if ( data->flags & QPaintEngine::DirtyPen )
+                pen = colorFilter.substituted( data->pen );
+
+            if ( data->flags & QPaintEngine::DirtyBrush )
+                brush = colorFilter.substituted( data->brush );
+
+            if ( data->flags & QPaintEngine::DirtyTransform )
+                transform = data->transform;
+
+            continue;
+        }
+
+        if ( command.type() != QskPainterCommand::Path )
+            continue;
+
+        const auto& path = *command.path();
+        const auto pathTransform = transform * scale;
+
+        if ( qskIsVisible( brush ) )
+        {
+            auto fillNode = qskNextNode< QskShapeNode >( this, node, FillRole );
+
+            const auto rect = pathTransform.mapRect( path.boundingRect() );
+            fillNode->updateNode( path, pathTransform, rect, brush.color() );
+        }
+
+        if ( qskIsVisible( pen ) )
+        {
+            /*
+                QskStrokeNode scales the pen by qMin( m11, m22 ) and rounds it
+                to an int, what fails for rotated or mirrored paths. So we
+                map the path and scale the pen by the area factor ourselves.
+             */
+            const auto width = pen.widthF()
+                * qSqrt( qAbs( pathTransform.determinant() ) );
+
+            if ( width > 0.0 )
+            {
+                auto strokePen = pen;
+                strokePen.setWidthF( width );
+
+                auto strokeNode = qskNextNode< QskStrokeNode >( this, node, StrokeRole );
+                strokeNode->updateNode( pathTransform.map( path ), QTransform(), strokePen );
+            }
+        }
+    }
+
+    QskSGNode::removeAllChildNodesFrom( this, node );
+}
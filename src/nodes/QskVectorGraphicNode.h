@@ -0,0 +1,58 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_VECTOR_GRAPHIC_NODE_H
+#define QSK_VECTOR_GRAPHIC_NODE_H
+
+#include "QskGlobal.h"
+#include <qsgnode.h>
+
+class QskGraphic;
+class QskColorFilter;
+
+/*
+    QskVectorGraphicNode converts the paths of a QskGraphic into
+    tessellated fill ( QskShapeNode ) and stroke ( QskStrokeNode ) geometries,
+    instead of rasterizing it into a texture like QskGraphicNode.
+
+    The geometry is created in the coordinate system of the graphic and
+    mapped to the target rectangle by the transformation of the node.
+    It is only recreated when the graphic/colors change or the scale
+    factor changes by more than a power of 2.
+ */
+class QSK_EXPORT QskVectorGraphicNode : public QSGTransformNode
+{
+  public:
+    QskVectorGraphicNode();
+    ~QskVectorGraphicNode() override;
+
+    /*
+        Graphics with raster data, clipping, composition modes,
+        opacities, cosmetic/unscaled pens or brushes other than solid
+        colors can't be displayed by this node.
+     */
+    static bool isSupported( const QskGraphic& );
+
+    // isSupported(), but cached for the graphic being displayed
+    bool canDisplay( const QskGraphic& ) const;
+
+    void setMirrored( Qt::Orientations );
+    Qt::Orientations mirrored() const;
+
+    void setGraphic( const QskGraphic&, const QskColorFilter&, const QRectF& );
+
+  private:
+    void updateChildNodes( const QskGraphic&, const QskColorFilter& );
+
+    QskHashValue m_hash;
+    qreal m_tessellationScale;
+
+    mutable QskHashValue m_supportHash;
+    mutable bool m_isSupported;
+
+    Qt::Orientations m_mirrored;
+};
+
+#endif
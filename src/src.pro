@@ -77,6 +77,7 @@ SOURCES += \
 HEADERS += \
     graphic/QskColorFilter.h \
     graphic/QskGraphic.h \
+    graphic/QskGraphicArchive.h \
     graphic/QskGraphicImageProvider.h \
     graphic/QskGraphicIO.h \
     graphic/QskGraphicPaintEngine.h \
@@ -89,6 +90,7 @@ HEADERS += \
 SOURCES += \
     graphic/QskColorFilter.cpp \
     graphic/QskGraphic.cpp \
+    graphic/QskGraphicArchive.cpp \
     graphic/QskGraphicImageProvider.cpp \
     graphic/QskGraphicIO.cpp \
     graphic/QskGraphicPaintEngine.cpp \
@@ -116,6 +118,7 @@ HEADERS += \
     nodes/QskPaintedNode.h \
     nodes/QskPlainTextRenderer.h \
     nodes/QskRectangleNode.h \
+    nodes/QskRenderContextWatcher.h \
     nodes/QskRichTextRenderer.h \
     nodes/QskScaleRenderer.h \
     nodes/QskSGNode.h \
@@ -123,9 +126,13 @@ HEADERS += \
     nodes/QskShapeNode.h \
     nodes/QskGradientMaterial.h \
     nodes/QskTextNode.h \
+    nodes/QskTextCache.h \
     nodes/QskTextRenderer.h \
+    nodes/QskTextureAtlas.h \
+    nodes/QskTextureCache.h \
     nodes/QskTextureRenderer.h \
     nodes/QskTickmarksNode.h \
+    nodes/QskVectorGraphicNode.h \
     nodes/QskVertex.h
 
 SOURCES += \
@@ -146,6 +153,7 @@ SOURCES += \
     nodes/QskPaintedNode.cpp \
     nodes/QskPlainTextRenderer.cpp \
     nodes/QskRectangleNode.cpp \
+    nodes/QskRenderContextWatcher.cpp \
     nodes/QskRichTextRenderer.cpp \
     nodes/QskScaleRenderer.cpp \
     nodes/QskSGNode.cpp \
@@ -153,9 +161,13 @@ SOURCES += \
     nodes/QskShapeNode.cpp \
     nodes/QskGradientMaterial.cpp \
     nodes/QskTextNode.cpp \
+    nodes/QskTextCache.cpp \
     nodes/QskTextRenderer.cpp \
+    nodes/QskTextureAtlas.cpp \
+    nodes/QskTextureCache.cpp \
     nodes/QskTextureRenderer.cpp \
     nodes/QskTickmarksNode.cpp \
+    nodes/QskVectorGraphicNode.cpp \
     nodes/QskVertex.cpp
 
 RESOURCES += \
@@ -215,11 +227,13 @@ HEADERS += \
     controls/QskSetup.h \
     controls/QskShortcutMap.h \
     controls/QskSimpleListBox.h \
+    controls/QskSizeHintCache.h \
     controls/QskSkin.h \
     controls/QskSkinFactory.h \
     controls/QskSkinHintTable.h \
     controls/QskSkinHintTableEditor.h \
     controls/QskSkinManager.h \
+    controls/QskSkinSnapshot.h \
     controls/QskSkinStateChanger.h \
     controls/QskSkinTransition.h \
     controls/QskSkinlet.h \
@@ -300,11 +314,13 @@ SOURCES += \
     controls/QskSetup.cpp \
     controls/QskShortcutMap.cpp \
     controls/QskSimpleListBox.cpp \
+    controls/QskSizeHintCache.cpp \
     controls/QskSkin.cpp \
     controls/QskSkinHintTable.cpp \
     controls/QskSkinHintTableEditor.cpp \
     controls/QskSkinFactory.cpp \
     controls/QskSkinManager.cpp \
+    controls/QskSkinSnapshot.cpp \
     controls/QskSkinTransition.cpp \
     controls/QskSkinlet.cpp \
     controls/QskSkinnable.cpp \
@@ -386,7 +402,8 @@ HEADERS += \
     inputpanel/QskInputPanel.h \
     inputpanel/QskInputPanelBox.h \
     inputpanel/QskInputPredictionBar.h \
-    inputpanel/QskVirtualKeyboard.h
+    inputpanel/QskVirtualKeyboard.h \
+    inputpanel/QskVirtualKeyboardSkinlet.h
 
 SOURCES += \
     inputpanel/QskTextPredictor.cpp \
@@ -394,7 +411,8 @@ SOURCES += \
     inputpanel/QskInputPanel.cpp \
     inputpanel/QskInputPanelBox.cpp \
     inputpanel/QskInputPredictionBar.cpp \
-    inputpanel/QskVirtualKeyboard.cpp
+    inputpanel/QskVirtualKeyboard.cpp \
+    inputpanel/QskVirtualKeyboardSkinlet.cpp
 
 
 pinyin {
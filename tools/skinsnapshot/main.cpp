@@ -0,0 +1,75 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include <QskSkin.h>
+#include <QskSkinManager.h>
+#include <QskSkinSnapshot.h>
+
+#include <QGuiApplication>
+#include <QDir>
+#include <QDebug>
+
+#include <memory>
+
+static void usage( const char* appName )
+{
+    qWarning() << "usage: " << appName << "directory [skin ...]";
+}
+
+int main( int argc, char* argv[] )
+{
+    if ( argc < 2 )
+    {
+        usage( argv[0] );
+        return -1;
+    }
+
+    /*
+        The skins convert their metrics from the resolution of
+        the primary screen, that is stored in the snapshots.
+        So this tool has to run on the screen, where the
+        snapshots will be used.
+     */
+    QGuiApplication app( argc, argv );
+
+    const QString directory = QString::fromLocal8Bit( argv[1] );
+    if ( !QDir().mkpath( directory ) )
+    {
+        qWarning() << "Can't create" << directory;
+        return -1;
+    }
+
+    QStringList skinNames;
+    for ( int i = 2; i < argc; i++ )
+        skinNames += QString::fromLocal8Bit( argv[i] );
+
+    auto manager = QskSkinManager::instance();
+
+    if ( skinNames.isEmpty() )
+        skinNames = manager->skinNames();
+
+    int status = 0;
+
+    for ( const auto& skinName : qAsConst( skinNames ) )
+    {
+        // no directory: the factories create the skins from their setup code
+        QskSkinSnapshot::setDirectory( QString() );
+        std::unique_ptr< QskSkin > skin( manager->createSkin( skinName ) );
+
+        QskSkinSnapshot::setDirectory( directory );
+        const auto fileName = QskSkinSnapshot::fileName( skinName );
+
+        if ( skin == nullptr || !QskSkinSnapshot::write( skin.get(), fileName ) )
+        {
+            qWarning() << "Can't write a snapshot for" << skinName;
+            status = -1;
+            continue;
+        }
+
+        qDebug() << skinName << "->" << fileName;
+    }
+
+    return status;
+}
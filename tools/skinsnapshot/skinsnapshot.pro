@@ -0,0 +1,14 @@
+TEMPLATE     = app
+TARGET = skinsnapshot
+
+CONFIG += qskinny
+CONFIG -= app_bundle
+CONFIG -= sanitize
+
+DESTDIR      = $${QSK_OUT_ROOT}/tools/bin
+
+SOURCES += \
+    main.cpp
+
+target.path    = $${QSK_INSTALL_BINS}
+INSTALLS       = target
@@ -10,24 +10,48 @@
 #include <QskPainterCommand.cpp>
 #include <QskGraphicPaintEngine.cpp>
 #include <QskGraphicIO.cpp>
+#include <QskGraphicArchive.cpp>
 #else
 #include <QskGraphicIO.h>
+#include <QskGraphicArchive.h>
 #include <QskGraphic.h>
 #endif
 
 #include <QGuiApplication>
 #include <QSvgRenderer>
 #include <QPainter>
+#include <QFileInfo>
 #include <QDebug>
 
+#include <cstring>
+
 static void usage( const char* appName )
 {
     qWarning() << "usage: " << appName << "svgfile qvgfile";
+    qWarning() << "       " << appName << "--archive archivefile svgfile ...";
+}
+
+static bool loadGraphic( const char* svgFile, QskGraphic& graphic )
+{
+    QSvgRenderer renderer;
+    if ( !renderer.load( QString( svgFile ) ) )
+        return false;
+
+    QPainter painter( &graphic );
+    renderer.render( &painter );
+    painter.end();
+
+    if ( graphic.commandTypes() & QskGraphic::RasterData )
+        qWarning() << svgFile << "contains non scalable parts.";
+
+    return true;
 }
 
 int main( int argc, char* argv[] )
 {
-    if ( argc != 3 )
+    const bool isArchive = ( argc > 1 ) && ( strcmp( argv[1], "--archive" ) == 0 );
+
+    if ( isArchive ? ( argc < 4 ) : ( argc != 3 ) )
     {
         usage( argv[0] );
         return -1;
@@ -51,18 +75,43 @@ int main( int argc, char* argv[] )
     QGuiApplication app( argc, argv );
 #endif
 
-    QSvgRenderer renderer;
-    if ( !renderer.load( QString( argv[1] ) ) )
-        return -2;
+    if ( isArchive )
+    {
+        /*
+            All SVGs are bundled into one file, where each graphic
+            can be found by the base name of its SVG.
+         */
+        QVector< QskGraphic > graphics;
+        QStringList names;
 
-    QskGraphic graphic;
+        for ( int i = 3; i < argc; i++ )
+        {
+            QskGraphic graphic;
+            if ( !loadGraphic( argv[i], graphic ) )
+            {
+                qWarning() << "can't load" << argv[i];
+                return -2;
+            }
 
-    QPainter painter( &graphic );
-    renderer.render( &painter );
-    painter.end();
+            graphics += graphic;
+            names += QFileInfo( QString( argv[i] ) ).completeBaseName();
+        }
 
-    if ( graphic.commandTypes() & QskGraphic::RasterData )
-        qWarning() << argv[1] << "contains non scalable parts.";
+        if ( names.removeDuplicates() > 0 )
+        {
+            qWarning() << "ambiguous file names";
+            return -3;
+        }
+
+        if ( !QskGraphicArchive::write( graphics, names, QString( argv[2] ) ) )
+            return -3;
+
+        return 0;
+    }
+
+    QskGraphic graphic;
+    if ( !loadGraphic( argv[1], graphic ) )
+        return -2;
 
     QskGraphicIO::write( graphic, argv[2] );
 
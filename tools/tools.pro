@@ -1,5 +1,8 @@
 TEMPLATE = subdirs
 
+SUBDIRS += \
+    skinsnapshot
+
 qtHaveModule(svg) {
 
     SUBDIRS += \